@@ -0,0 +1,121 @@
+#ifndef ANAHTAR_KELIMELER_H
+#define ANAHTAR_KELIMELER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Vurgulayıcının ve parser'ın tanıdığı ayrılmış kelimeler
+// Bir kelimenin türleri bit bayraklarıdır; örneğin "int" hem vurgulanan
+// bir anahtar kelime hem de parser için bir veri tipidir.
+enum KelimeTuru : uint8_t {
+    KT_YOK = 0,
+    KT_ANAHTAR = 1,   // Vurgulanan anahtar kelime (bütün C anahtar kelimeleri ve tip adları)
+    KT_TIP = 2,       // Parser'ın veri tipi olarak tanıdığı ad
+    KT_DEYIM = 4      // Parser'ın tanımlayıcı olarak kabul etmediği deyim kelimesi
+};
+
+namespace anahtar_kelime_detay {
+
+struct Kelime {
+    const char *yazi;
+    uint8_t tur;
+};
+
+// C11 anahtar kelimeleri ve parser'ın tip adları
+constexpr Kelime kelimeler[] = {
+    {"auto", KT_ANAHTAR}, {"break", KT_ANAHTAR | KT_DEYIM}, {"case", KT_ANAHTAR},
+    {"char", KT_ANAHTAR | KT_TIP}, {"const", KT_ANAHTAR}, {"continue", KT_ANAHTAR | KT_DEYIM},
+    {"default", KT_ANAHTAR}, {"do", KT_ANAHTAR}, {"double", KT_ANAHTAR | KT_TIP},
+    {"else", KT_ANAHTAR | KT_DEYIM}, {"enum", KT_ANAHTAR}, {"extern", KT_ANAHTAR},
+    {"float", KT_ANAHTAR | KT_TIP}, {"for", KT_ANAHTAR | KT_DEYIM}, {"goto", KT_ANAHTAR},
+    {"if", KT_ANAHTAR | KT_DEYIM}, {"inline", KT_ANAHTAR}, {"int", KT_ANAHTAR | KT_TIP},
+    {"long", KT_ANAHTAR}, {"register", KT_ANAHTAR}, {"restrict", KT_ANAHTAR},
+    {"return", KT_ANAHTAR | KT_DEYIM}, {"short", KT_ANAHTAR}, {"signed", KT_ANAHTAR},
+    {"sizeof", KT_ANAHTAR}, {"static", KT_ANAHTAR}, {"struct", KT_ANAHTAR},
+    {"switch", KT_ANAHTAR}, {"typedef", KT_ANAHTAR}, {"union", KT_ANAHTAR},
+    {"unsigned", KT_ANAHTAR}, {"void", KT_ANAHTAR | KT_TIP}, {"volatile", KT_ANAHTAR},
+    {"while", KT_ANAHTAR | KT_DEYIM}, {"_Alignas", KT_ANAHTAR}, {"_Alignof", KT_ANAHTAR},
+    {"_Atomic", KT_ANAHTAR}, {"_Bool", KT_ANAHTAR}, {"_Complex", KT_ANAHTAR},
+    {"_Generic", KT_ANAHTAR}, {"_Imaginary", KT_ANAHTAR}, {"_Noreturn", KT_ANAHTAR},
+    {"_Static_assert", KT_ANAHTAR}, {"_Thread_local", KT_ANAHTAR},
+    {"string", KT_ANAHTAR | KT_TIP}, {"bool", KT_ANAHTAR | KT_TIP},
+};
+constexpr size_t KELIME_SAYISI = sizeof(kelimeler) / sizeof(kelimeler[0]);
+
+constexpr size_t uzunluk(const char *s) {
+    size_t n = 0;
+    while (s[n]) ++n;
+    return n;
+}
+
+// Mükemmel özet: uzunluk, ilk, orta ve son karakterden oluşan anahtar bir
+// çarpanla karıştırılır ve üst YUVA_BITI biti alınır. Çarpan, bütün
+// kelimeler farklı yuvalara düşene kadar derleme anında aranır.
+constexpr unsigned YUVA_BITI = 8;
+constexpr size_t YUVA_SAYISI = size_t(1) << YUVA_BITI;
+
+constexpr uint32_t anahtar(const char *p, size_t n) {
+    return (uint32_t)n | (uint32_t)(unsigned char)p[0] << 8 | (uint32_t)(unsigned char)p[n / 2] << 16 |
+           (uint32_t)(unsigned char)p[n - 1] << 24;
+}
+
+constexpr uint32_t yuva(uint32_t anahtarDegeri, uint32_t carpan) {
+    return (uint32_t)(anahtarDegeri * carpan) >> (32 - YUVA_BITI);
+}
+
+constexpr bool carpanUygunMu(uint32_t carpan) {
+    bool dolu[YUVA_SAYISI] = {};
+    for (size_t i = 0; i < KELIME_SAYISI; ++i) {
+        uint32_t y = yuva(anahtar(kelimeler[i].yazi, uzunluk(kelimeler[i].yazi)), carpan);
+        if (dolu[y]) return false;
+        dolu[y] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t carpanBul() {
+    for (uint32_t c = 0x9E3779B1u; c != 0x9E3779B1u + 2 * 100000; c += 2) {
+        if (carpanUygunMu(c)) return c;
+    }
+    return 0;
+}
+
+constexpr uint32_t CARPAN = carpanBul();
+static_assert(CARPAN != 0, "anahtar kelimeler için mükemmel özet çarpanı bulunamadı");
+
+// Her yuvada kelimenin indeksi + 1 (0: boş) ve uzunluğu
+struct YuvaTablosu {
+    uint8_t kelime[YUVA_SAYISI];
+    uint8_t boy[YUVA_SAYISI];
+    constexpr YuvaTablosu() : kelime(), boy() {
+        for (size_t i = 0; i < KELIME_SAYISI; ++i) {
+            size_t n = uzunluk(kelimeler[i].yazi);
+            uint32_t y = yuva(anahtar(kelimeler[i].yazi, n), CARPAN);
+            kelime[y] = (uint8_t)(i + 1);
+            boy[y] = (uint8_t)n;
+        }
+    }
+};
+constexpr YuvaTablosu yuvalar;
+
+} // namespace anahtar_kelime_detay
+
+// Kelimenin türlerini döndürür (ayrılmış bir kelime değilse KT_YOK)
+// Tek bir tablo okuması ve en fazla bir karşılaştırma yapar; bellek ayırmaz.
+inline uint8_t kelimeTuru(const char *p, size_t n) {
+    using namespace anahtar_kelime_detay;
+    if (n == 0) return KT_YOK;
+    uint32_t y = yuva(anahtar(p, n), CARPAN);
+    uint8_t i = yuvalar.kelime[y];
+    if (i == 0 || yuvalar.boy[y] != n) return KT_YOK;
+    const char *aday = kelimeler[i - 1].yazi;
+    for (size_t k = 0; k < n; ++k) {
+        if (aday[k] != p[k]) return KT_YOK;
+    }
+    return kelimeler[i - 1].tur;
+}
+
+inline uint8_t kelimeTuru(std::string_view kelime) { return kelimeTuru(kelime.data(), kelime.size()); }
+
+#endif
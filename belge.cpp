@@ -0,0 +1,148 @@
+#include "belge.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+
+using belge_detay::boyut;
+using belge_detay::Dugum;
+using belge_detay::DugumPtr;
+using belge_detay::Tampon;
+
+// Bir parçanın yerini tutan yeni düğüm; alt ağaçlar paylaşılır
+DugumPtr yeniDugum(const DugumPtr &sol, const DugumPtr &sag, const std::shared_ptr<const Tampon> &tampon,
+                   const char *veri, size_t uzunluk, uint32_t oncelik) {
+    std::shared_ptr<Dugum> d = std::make_shared<Dugum>();
+    d->sol = sol;
+    d->sag = sag;
+    d->tampon = tampon;
+    d->veri = veri;
+    d->uzunluk = uzunluk;
+    d->toplam = boyut(sol.get()) + uzunluk + boyut(sag.get());
+    d->oncelik = oncelik;
+    return d;
+}
+
+DugumPtr altlariDegistir(const Dugum &d, const DugumPtr &sol, const DugumPtr &sag) {
+    return yeniDugum(sol, sag, d.tampon, d.veri, d.uzunluk, d.oncelik);
+}
+
+// Ağacı parça sınırında ayırır: ilk k bayt, k'yi içeren parça ve geri kalanı
+// k bir parçanın ortasına düşmezse 'orta' boştur. Parçalara dokunulmadığı için
+// iki taraf da öncelik sırasını korur.
+struct Ayrim {
+    DugumPtr sol, sag;
+    const Dugum *orta;  // Ayrılan ağacın içindeki düğüm; ağaç yaşadıkça geçerlidir
+    size_t kesim;       // k'nin 'orta' parçanın başına göre yeri
+};
+
+Ayrim ayir(const DugumPtr &d, size_t k) {
+    if (!d) return {nullptr, nullptr, nullptr, 0};
+    size_t solBoyut = boyut(d->sol.get());
+    if (k <= solBoyut) {
+        Ayrim a = ayir(d->sol, k);
+        a.sag = altlariDegistir(*d, a.sag, d->sag);
+        return a;
+    }
+    size_t parcaSonu = solBoyut + d->uzunluk;
+    if (k >= parcaSonu) {
+        Ayrim a = ayir(d->sag, k - parcaSonu);
+        a.sol = altlariDegistir(*d, d->sol, a.sol);
+        return a;
+    }
+    return {d->sol, d->sag, d.get(), k - solBoyut};
+}
+
+// a'nın bütün metninden sonra b'ninki gelecek şekilde iki ağacı birleştirir
+DugumPtr birlestir(const DugumPtr &a, const DugumPtr &b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->oncelik > b->oncelik) return altlariDegistir(*a, a->sol, birlestir(a->sag, b));
+    return altlariDegistir(*b, birlestir(a, b->sol), b->sag);
+}
+
+// Ağacı ilk k bayt ve geri kalanı olarak ikiye ayırır
+// k bir parçanın ortasına düşerse parça iki düğüme bölünür. İki yarı yeni
+// rastgele öncelikler alıp birlestir() ile yerleşir; bölünen parçanın
+// önceliğini taşısalar ard arda bölmeler ağacı bir zincire çevirirdi.
+template <typename F>
+std::pair<DugumPtr, DugumPtr> bol(const DugumPtr &d, size_t k, F &&oncelik) {
+    Ayrim a = ayir(d, k);
+    if (!a.orta) return {a.sol, a.sag};
+    const Dugum &p = *a.orta;
+    return {birlestir(a.sol, yeniDugum(nullptr, nullptr, p.tampon, p.veri, a.kesim, oncelik())),
+            birlestir(yeniDugum(nullptr, nullptr, p.tampon, p.veri + a.kesim, p.uzunluk - a.kesim, oncelik()), a.sag)};
+}
+
+// Metnin son parçasının düğümü (ağaç boşsa nullptr)
+const Dugum *sonParca(const Dugum *d) {
+    if (d) {
+        while (d->sag) d = d->sag.get();
+    }
+    return d;
+}
+
+// Son parçayı n bayt uzatır; uzatılan baytlar aynı tamponda parçanın hemen ardındadır
+DugumPtr sonuUzat(const Dugum &d, size_t n) {
+    if (!d.sag) return yeniDugum(d.sol, nullptr, d.tampon, d.veri, d.uzunluk + n, d.oncelik);
+    return altlariDegistir(d, d.sol, sonuUzat(*d.sag, n));
+}
+
+size_t parcalariSay(const Dugum *d) {
+    size_t n = 0;
+    for (; d; d = d->sag.get()) n += 1 + parcalariSay(d->sol.get());
+    return n;
+}
+
+} // namespace
+
+size_t BelgeGoruntusu::parcaSayisi() const {
+    return parcalariSay(kok.get());
+}
+
+uint32_t Belge::oncelik() {
+    rastgele ^= rastgele << 13;
+    rastgele ^= rastgele >> 17;
+    rastgele ^= rastgele << 5;
+    return rastgele;
+}
+
+void Belge::yukle(const char *metin, size_t uzunluk) {
+    ek.reset();
+    simdiki.kok.reset();
+    ++simdiki.surumNo;
+    if (uzunluk == 0) return;
+    std::shared_ptr<Tampon> tampon = std::make_shared<Tampon>();
+    tampon->veri.reset(new char[uzunluk]);
+    std::memcpy(tampon->veri.get(), metin, uzunluk);
+    tampon->kapasite = tampon->dolu = uzunluk;
+    simdiki.kok = yeniDugum(nullptr, nullptr, tampon, tampon->veri.get(), uzunluk, oncelik());
+}
+
+void Belge::degistir(size_t pos, size_t silinen, const char *eklenen, size_t eklenenUzunluk) {
+    auto yeniOncelik = [this] { return oncelik(); };
+    std::pair<DugumPtr, DugumPtr> bas = bol(simdiki.kok, pos, yeniOncelik);
+    DugumPtr son = bol(bas.second, silinen, yeniOncelik).second;
+    DugumPtr sol = bas.first;
+    if (eklenenUzunluk) {
+        if (!ek || ek->kapasite - ek->dolu < eklenenUzunluk) {
+            ek = std::make_shared<Tampon>();
+            ek->kapasite = std::max(EK_BLOGU, eklenenUzunluk);
+            ek->veri.reset(new char[ek->kapasite]);
+            ek->dolu = 0;
+        }
+        char *hedef = ek->veri.get() + ek->dolu;
+        std::memcpy(hedef, eklenen, eklenenUzunluk);
+        ek->dolu += eklenenUzunluk;
+        // Art arda yazılan karakterler tampona da art arda düşer; yeni parça
+        // açmak yerine önceki parça uzatılır ve ağaç büyümez
+        const Dugum *onceki = sonParca(sol.get());
+        if (onceki && onceki->tampon == ek && onceki->veri + onceki->uzunluk == hedef) {
+            sol = sonuUzat(*sol, eklenenUzunluk);
+        } else {
+            sol = birlestir(sol, yeniDugum(nullptr, nullptr, ek, hedef, eklenenUzunluk, oncelik()));
+        }
+    }
+    simdiki.kok = birlestir(sol, son);
+    ++simdiki.surumNo;
+}
@@ -0,0 +1,127 @@
+#ifndef BELGE_H
+#define BELGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "lexer.h"
+
+// Belgenin metni için kalıcı (persistent) parça tablosu
+// Metin, salt okunur tamponlardaki parçaların sırasıdır; parçalar boyutlarına
+// göre dengelenen bir treap'te tutulur. Bir düzenleme ağacı değiştirmez, yalnızca
+// kökten değişen parçaya giden yolu kopyalar (beklenen O(log n)). Bu yüzden
+// alınmış bir görüntü sonraki düzenlemelerden etkilenmez ve başka iş
+// parçacıklarında kilitsiz okunabilir.
+namespace belge_detay {
+
+// Yalnızca sonuna eklenen metin bloğu
+// Bir parçanın gösterdiği baytlar bir daha yazılmaz; blok yer değiştirmez.
+struct Tampon {
+    std::unique_ptr<char[]> veri;
+    size_t kapasite;
+    size_t dolu;
+};
+
+struct Dugum {
+    std::shared_ptr<const Dugum> sol, sag;
+    std::shared_ptr<const Tampon> tampon;  // Parçanın baytlarını yaşatır
+    const char *veri;                      // Parçanın başlangıcı (tampon içinde)
+    size_t uzunluk;                        // Parçanın uzunluğu
+    size_t toplam;                         // Alt ağaçtaki bütün parçaların uzunluğu
+    uint32_t oncelik;                      // Treap önceliği (üst düğümünkinden büyük değil)
+};
+typedef std::shared_ptr<const Dugum> DugumPtr;
+
+inline size_t boyut(const Dugum *d) { return d ? d->toplam : 0; }
+
+// [bas, bit) aralığındaki parçaları sırayla f(veri, uzunluk) ile gezer
+// bas ve bit, d'nin alt ağacının başına göredir
+template <typename F>
+void gez(const Dugum *d, size_t bas, size_t bit, F &f) {
+    while (d && bas < bit) {
+        size_t solBoyut = boyut(d->sol.get());
+        if (bas < solBoyut) gez(d->sol.get(), bas, std::min(bit, solBoyut), f);
+        size_t parcaSonu = solBoyut + d->uzunluk;
+        size_t pb = std::max(bas, solBoyut), pe = std::min(bit, parcaSonu);
+        if (pb < pe) f(d->veri + (pb - solBoyut), pe - pb);
+        if (bit <= parcaSonu) return;
+        // Sağ alt ağaç döngüyle gezilir; derinlik yalnızca sol dallarda artar
+        bas = bas > parcaSonu ? bas - parcaSonu : 0;
+        bit -= parcaSonu;
+        d = d->sag.get();
+    }
+}
+
+} // namespace belge_detay
+
+// Belgenin bir revizyonundaki değişmez metni
+// Kopyalamak yalnızca bir referans sayacını artırır. Metin hiçbir zaman
+// tek parça halinde tutulmaz; okuyucular onu parça parça gezer veya
+// yalnızca ihtiyaç duydukları aralığı kopyalar.
+class BelgeGoruntusu {
+public:
+    BelgeGoruntusu() : surumNo(0) {}
+
+    size_t uzunluk() const { return belge_detay::boyut(kok.get()); }
+    // Görüntünün alındığı belge sürümü (her düzenlemede artar)
+    unsigned long surum() const { return surumNo; }
+    // [baslangic, bitis) aralığını kopyalamadan, sırayla f(const char *veri, size_t uzunluk) ile gezer
+    template <typename F>
+    void gez(size_t baslangic, size_t bitis, F &&f) const {
+        belge_detay::gez(kok.get(), baslangic, std::min(bitis, uzunluk()), f);
+    }
+    // [baslangic, bitis) aralığını hedefe kopyalar
+    void oku(size_t baslangic, size_t bitis, std::string &hedef) const {
+        hedef.clear();
+        ekle(baslangic, bitis, hedef);
+    }
+    // [baslangic, bitis) aralığını hedefin sonuna ekler
+    void ekle(size_t baslangic, size_t bitis, std::string &hedef) const {
+        gez(baslangic, bitis, [&hedef](const char *p, size_t n) { hedef.append(p, n); });
+    }
+    // Görüntüdeki parça sayısı (yalnızca ölçüm için; O(n))
+    size_t parcaSayisi() const;
+
+private:
+    friend class Belge;
+    belge_detay::DugumPtr kok;
+    unsigned long surumNo;
+};
+
+// Düzenleyicideki belgenin metni
+// Düzenleyicinin değişiklik callback'inden her düzenlemeyle güncellenir ve
+// lexer'a metin kaynağı olarak sunulur. goruntu() o anki metnin değişmez bir
+// görüntüsünü verir; arka plan iş parçacıkları metni bu görüntüden okur.
+// Belge yalnızca bir iş parçacığından düzenlenmelidir.
+class Belge : public MetinKaynagi {
+public:
+    Belge() : rastgele(0x9E3779B9u) {}
+
+    // Bütün metni değiştirir
+    void yukle(const char *metin, size_t uzunluk);
+    // [pos, pos + silinen) aralığını siler ve yerine 'eklenen'in ilk
+    // 'eklenenUzunluk' baytını ekler
+    void degistir(size_t pos, size_t silinen, const char *eklenen, size_t eklenenUzunluk);
+
+    const BelgeGoruntusu &goruntu() const { return simdiki; }
+    unsigned long surum() const { return simdiki.surumNo; }
+
+    size_t uzunluk() const override { return simdiki.uzunluk(); }
+    void oku(size_t baslangic, size_t bitis, std::string &hedef) const override {
+        simdiki.oku(baslangic, bitis, hedef);
+    }
+
+private:
+    // Eklenen metinlerin biriktirildiği blokların en küçük boyutu
+    static constexpr size_t EK_BLOGU = 64 * 1024;
+
+    BelgeGoruntusu simdiki;                    // Güncel metin
+    std::shared_ptr<belge_detay::Tampon> ek;   // Eklenen metnin yazıldığı blok
+    uint32_t rastgele;                         // Treap öncelikleri için xorshift durumu
+
+    uint32_t oncelik();
+};
+
+#endif
@@ -0,0 +1,288 @@
+// Ölçüm takımı
+// Sentetik C korpusları (bench/korpus.h) üzerinde düzenleyicinin dört
+// aşamasını ayrı ayrı ölçer:
+//   tokenize  TokenAkisi::yenidenOlustur (belge açıldığındaki lexleme)
+//   vurgula   Bütün metnin stil karakterlerinin hesaplanması
+//   parse     Parser::parse (aynı ParseTree yeniden kullanılarak)
+//   agac      Ağaç görünümünün dolduruluşu: her öğenin etiketi ParseTreeWindow
+//             ile aynı biçimde üretilir (FLTK öğeleri oluşturulmaz)
+// Her aşama en az 3 kez ve toplamda en az --sure saniye çalıştırılır; en iyi
+// süre raporlanır. Bellek ayırmaları ilk çalıştırmada sayılır. Sonuçlar
+// JSON olarak standart çıktıya veya --cikti dosyasına yazılır.
+//
+// Kullanım: bench_suite [--buyuk] [--sure saniye] [--cikti dosya]
+//                       [--boyut bayt] [--yorum oran] [--metin oran]
+//                       [--derinlik n] [--fonksiyon n] [--tohum n]
+// Korpus ayarlarından biri verilirse varsayılan takım yerine yalnızca o
+// ayarlarla üretilen korpus ölçülür. --buyuk takıma 100 MB'lık korpusu ekler.
+#include "../belge.h"
+#include "../lexer.h"
+#include "../parser.h"
+#include "../tarama.h"
+#include "korpus.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// operator new çağrılarını sayar
+size_t ayrilanBayt = 0;
+size_t ayirmaSayisi = 0;
+
+struct Durum {
+    const char *ad;
+    KorpusAyarlari ayarlar;
+};
+
+struct AsamaSonucu {
+    const char *ad;
+    double sure;          // En iyi çalıştırmanın süresi (saniye)
+    int tekrar;
+    size_t ayirma;        // İlk çalıştırmadaki operator new çağrıları
+    size_t ayrilanBayt;
+};
+
+// En yüksek yerleşik bellek (KB)
+// Linux'ta /proc/self/clear_refs ile her durumdan önce sıfırlanır; sıfırlanamayan
+// sistemlerde süreç boyunca görülen en yüksek değerdir.
+bool tepeBellekSifirla() {
+    FILE *f = std::fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool tamam = std::fputs("5", f) >= 0;
+    return std::fclose(f) == 0 && tamam;
+}
+
+long tepeBellek() {
+    if (FILE *f = std::fopen("/proc/self/status", "r")) {
+        char satir[256];
+        long kb = -1;
+        while (std::fgets(satir, sizeof(satir), f)) {
+            if (std::strncmp(satir, "VmHWM:", 6) == 0) {
+                kb = std::atol(satir + 6);
+                break;
+            }
+        }
+        std::fclose(f);
+        if (kb >= 0) return kb;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage kullanim;
+    if (getrusage(RUSAGE_SELF, &kullanim) == 0) {
+#ifdef __APPLE__
+        return kullanim.ru_maxrss / 1024;
+#else
+        return kullanim.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+AsamaSonucu olc(const char *ad, double enAzSure, const std::function<void()> &calistir) {
+    AsamaSonucu sonuc = {ad, 0, 0, 0, 0};
+    double toplam = 0;
+    while (sonuc.tekrar < 3 || toplam < enAzSure) {
+        size_t bayt0 = ayrilanBayt, ayirma0 = ayirmaSayisi;
+        auto bas = std::chrono::steady_clock::now();
+        calistir();
+        std::chrono::duration<double> gecen = std::chrono::steady_clock::now() - bas;
+        if (sonuc.tekrar == 0) {
+            sonuc.ayirma = ayirmaSayisi - ayirma0;
+            sonuc.ayrilanBayt = ayrilanBayt - bayt0;
+            sonuc.sure = gecen.count();
+        } else if (gecen.count() < sonuc.sure) {
+            sonuc.sure = gecen.count();
+        }
+        toplam += gecen.count();
+        ++sonuc.tekrar;
+    }
+    return sonuc;
+}
+
+// ParseTreeWindow::entryLabel ile aynı etiketleri üretir
+void etiketleriUret(const ParseTree &agac, NodeId dugum, const char *rol, std::vector<std::string> &etiketler) {
+    if (rol) {
+        etiketler.emplace_back(rol);
+        etiketleriUret(agac, dugum, nullptr, etiketler);
+        return;
+    }
+    NodeType tip = agac.type(dugum);
+    std::string etiket = nodeTypeName(tip);
+    std::string_view deger = agac.value(dugum);
+    if (!deger.empty() && tip != IF_STATEMENT && tip != WHILE_STATEMENT && tip != FOR_STATEMENT) {
+        etiket += ": ";
+        etiket += deger;
+    }
+    etiketler.push_back(std::move(etiket));
+    for (uint32_t i = 0; i < agac.childCount(dugum); ++i) {
+        etiketleriUret(agac, agac.child(dugum, i), childRole(tip, i), etiketler);
+    }
+}
+
+const char *seviyeAdi(TaramaSeviyesi seviye) {
+    switch (seviye) {
+        case TS_AVX2: return "avx2";
+        case TS_SSE2: return "sse2";
+        default: return "skaler";
+    }
+}
+
+void durumOlc(FILE *cikti, const Durum &durum, double enAzSure, bool ilk) {
+    std::string metin = korpusUret(durum.ayarlar);
+    const double mb = metin.size() / (1024.0 * 1024.0);
+    bool sifirlandi = tepeBellekSifirla();
+
+    Belge belge;
+    belge.yukle(metin.data(), metin.size());
+    TokenAkisi akis(belge);
+    std::string stil;
+    Parser parser;
+    ParseTree agac;
+    std::vector<std::string> etiketler;
+
+    AsamaSonucu asamalar[4];
+    asamalar[0] = olc("tokenize", enAzSure, [&] { akis.yenidenOlustur(); });
+    const TokenDeposu &tokenlar = akis.getTokenlar();
+    asamalar[1] = olc("vurgula", enAzSure, [&] {
+        stilleriHesapla(tokenlar, 0, (int)metin.size(), stil);
+    });
+    // Parser düz token dizisiyle çalışır; açılım ölçülen süreye katılmaz
+    std::vector<Token> duzTokenlar;
+    tokenlar.kopyala(duzTokenlar);
+    asamalar[2] = olc("parse", enAzSure, [&] { parser.parse(metin, duzTokenlar, agac); });
+    asamalar[3] = olc("agac", enAzSure, [&] {
+        etiketler.clear();
+        etiketleriUret(agac, agac.root(), nullptr, etiketler);
+    });
+    long tepe = tepeBellek();
+
+    std::fprintf(cikti, "%s\n    {\"name\": \"%s\", \"bytes\": %zu, \"tokens\": %zu, \"nodes\": %zu, \"items\": %zu,\n"
+                 "     \"token_bytes\": %zu,\n",
+                 ilk ? "" : ",", durum.ad, metin.size(), tokenlar.size(), agac.nodeCount(), etiketler.size(),
+                 tokenlar.bellek());
+    std::fprintf(cikti,
+                 "     \"corpus\": {\"comment_density\": %.3f, \"string_density\": %.3f, \"nesting_depth\": %d, "
+                 "\"function_size\": %d, \"seed\": %llu},\n",
+                 durum.ayarlar.yorumYogunlugu, durum.ayarlar.metinYogunlugu, durum.ayarlar.derinlik,
+                 durum.ayarlar.fonksiyonBoyutu, (unsigned long long)durum.ayarlar.tohum);
+    std::fprintf(cikti, "     \"peak_rss_kb\": %ld, \"peak_rss_per_case\": %s,\n     \"stages\": {", tepe,
+                 sifirlandi ? "true" : "false");
+    for (int i = 0; i < 4; ++i) {
+        const AsamaSonucu &a = asamalar[i];
+        double sure = a.sure > 0 ? a.sure : 1e-9;
+        std::fprintf(cikti,
+                     "%s\n       \"%s\": {\"seconds\": %.9f, \"runs\": %d, \"mb_per_s\": %.2f, \"tokens_per_s\": %.0f, "
+                     "\"allocs\": %zu, \"alloc_bytes\": %zu}",
+                     i ? "," : "", a.ad, a.sure, a.tekrar, mb / sure, tokenlar.size() / sure, a.ayirma,
+                     a.ayrilanBayt);
+    }
+    std::fprintf(cikti, "}}");
+    std::fflush(cikti);
+    // İlerleme standart hataya
+    std::fprintf(stderr, "%-16s %8.2f MB  tokenize %8.1f MB/s  vurgula %8.1f MB/s  parse %8.1f MB/s  agac %8.1f MB/s  tepe %ld KB\n",
+                 durum.ad, mb, mb / asamalar[0].sure, mb / asamalar[1].sure, mb / asamalar[2].sure,
+                 mb / asamalar[3].sure, tepe);
+}
+
+int kullanim() {
+    std::fprintf(stderr,
+                 "kullanim: bench_suite [--buyuk] [--sure saniye] [--cikti dosya]\n"
+                 "                      [--boyut bayt] [--yorum oran] [--metin oran]\n"
+                 "                      [--derinlik n] [--fonksiyon n] [--tohum n]\n");
+    return 2;
+}
+
+} // namespace
+
+void *operator new(size_t boyut) {
+    ayrilanBayt += boyut;
+    ++ayirmaSayisi;
+    if (void *p = std::malloc(boyut ? boyut : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char **argv) {
+    bool buyuk = false;
+    double enAzSure = 0.2;
+    const char *ciktiYolu = nullptr;
+    KorpusAyarlari ozel;
+    bool ozelVar = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string secenek = argv[i];
+        if (secenek == "--buyuk") {
+            buyuk = true;
+            continue;
+        }
+        if (i + 1 >= argc) return kullanim();
+        const char *deger = argv[++i];
+        if (secenek == "--sure") enAzSure = std::atof(deger);
+        else if (secenek == "--cikti") ciktiYolu = deger;
+        else {
+            ozelVar = true;
+            if (secenek == "--boyut") ozel.boyut = (size_t)std::strtoull(deger, nullptr, 10);
+            else if (secenek == "--yorum") ozel.yorumYogunlugu = std::atof(deger);
+            else if (secenek == "--metin") ozel.metinYogunlugu = std::atof(deger);
+            else if (secenek == "--derinlik") ozel.derinlik = std::atoi(deger);
+            else if (secenek == "--fonksiyon") ozel.fonksiyonBoyutu = std::atoi(deger);
+            else if (secenek == "--tohum") ozel.tohum = std::strtoull(deger, nullptr, 10);
+            else return kullanim();
+        }
+    }
+
+    std::vector<Durum> durumlar;
+    if (ozelVar) {
+        durumlar.push_back(Durum{"ozel", ozel});
+    } else {
+        KorpusAyarlari a;
+        a.boyut = 1u << 10;
+        durumlar.push_back(Durum{"1kb", a});
+        a.boyut = 1u << 20;
+        durumlar.push_back(Durum{"1mb", a});
+        a.boyut = 16u << 20;
+        durumlar.push_back(Durum{"16mb", a});
+        if (buyuk) {
+            a.boyut = 100u << 20;
+            durumlar.push_back(Durum{"100mb", a});
+        }
+        KorpusAyarlari yorumlu;
+        yorumlu.boyut = 4u << 20;
+        yorumlu.yorumYogunlugu = 0.8;
+        durumlar.push_back(Durum{"yorum_agirlikli", yorumlu});
+        KorpusAyarlari metinli;
+        metinli.boyut = 4u << 20;
+        metinli.metinYogunlugu = 0.6;
+        durumlar.push_back(Durum{"metin_agirlikli", metinli});
+        KorpusAyarlari derin;
+        derin.boyut = 4u << 20;
+        derin.derinlik = 10;
+        derin.fonksiyonBoyutu = 4;
+        durumlar.push_back(Durum{"derin_ic_ice", derin});
+    }
+
+    FILE *cikti = stdout;
+    if (ciktiYolu) {
+        cikti = std::fopen(ciktiYolu, "w");
+        if (!cikti) {
+            std::fprintf(stderr, "%s: acilamadi\n", ciktiYolu);
+            return 1;
+        }
+    }
+    std::fprintf(cikti, "{\"scan_level\": \"%s\", \"min_seconds\": %.3f, \"cases\": [",
+                 seviyeAdi(taramaSeviyesi()), enAzSure);
+    for (size_t i = 0; i < durumlar.size(); ++i) durumOlc(cikti, durumlar[i], enAzSure, i == 0);
+    std::fprintf(cikti, "\n]}\n");
+    if (cikti != stdout) std::fclose(cikti);
+    return 0;
+}
@@ -0,0 +1,276 @@
+// Tuş vuruşu gecikmesi ölçümü
+// Bir metni Fl_Text_Buffer'a yükler, düzenleyicideki gerçek değişiklik
+// callback'ini (metin_degisti_cb) bağlar ve bir düzenleme betiğini yeniden
+// oynatır. Her düzenlemenin süresi, buffer'ın insert/remove/replace çağrısından
+// callback'lerin bitişine kadar ölçülür; çizim dahil değildir. Pencere açılmaz.
+// Düzenleyicinin boşta tamamladığı kısım her düzenlemeden sonra ölçüm dışında
+// tamamlanır; her düzenleme tamamen renklendirilmiş bir metinden başlar.
+//
+// Betik bir dosyadan okunur (duzenleme_betigi.h; düzenleyici SYNTAX_KAYIT ile
+// kaydedebilir) veya sentetik olarak üretilir: satır yazma, geri silme, blok
+// yapıştırma, satır silme ve kapatılmamış bir "/*" açıp geri silme.
+//
+// Kullanım: gecikme_bench [--dosya yol | --boyut bayt] [--betik dosya]
+//                         [--betik-yaz dosya] [--oturum n] [--tohum n]
+//                         [--butce ms] [--cikti dosya]
+// --butce verilirse p99 gecikmesi bütçeyi aşan bir düzenleme türü olduğunda
+// program 1 ile çıkar.
+#include "../duzenleme_betigi.h"
+#include "../vurgulayici.h"
+#include "korpus.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+// splitmix64
+struct Rastgele {
+    uint64_t durum;
+    uint64_t sonraki() {
+        uint64_t z = (durum += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // [0, n) aralığında bir sayı
+    size_t sayi(size_t n) { return n ? (size_t)(sonraki() % n) : 0; }
+};
+
+// Sentetik betik üretici
+// Düzenlemeler metnin bir kopyasına da uygulanır ki satır sınırları ve
+// konumlar her adımda geçerli olsun
+class BetikUretici {
+public:
+    BetikUretici(const std::string &metin, uint64_t tohum) : kopya(metin), rastgele{tohum} {
+        KorpusAyarlari ayarlar;
+        ayarlar.boyut = 64u << 10;
+        ayarlar.tohum = tohum + 1;
+        yapistirilacak = korpusUret(ayarlar);
+    }
+
+    void oturumEkle(std::vector<Duzenleme> &betik) {
+        switch (rastgele.sayi(4)) {
+            case 0: satirYaz(betik); break;
+            case 1: blokYapistir(betik); break;
+            case 2: satirSil(betik); break;
+            default: yorumAcKapat(betik); break;
+        }
+    }
+
+private:
+    std::string kopya;
+    Rastgele rastgele;
+    std::string yapistirilacak;  // Yapıştırılan blokların alındığı metin
+
+    void uygula(std::vector<Duzenleme> &betik, const char *tur, int konum, int silinen, const std::string &eklenen) {
+        kopya.replace(konum, silinen, eklenen);
+        betik.push_back(Duzenleme{tur, konum, silinen, eklenen});
+    }
+
+    int rastgeleSatirBasi() {
+        if (kopya.empty()) return 0;
+        size_t konum = rastgele.sayi(kopya.size());
+        size_t bas = konum == 0 ? std::string::npos : kopya.rfind('\n', konum - 1);
+        return bas == std::string::npos ? 0 : (int)bas + 1;
+    }
+
+    // Bir satırı karakter karakter yazar, sonra son birkaç karakteri geri siler
+    void satirYaz(std::vector<Duzenleme> &betik) {
+        static const char *const satirlar[] = {
+            "    int toplam = toplam + deger * 2;\n",
+            "    if (x > 0) { y = y - 1; }\n",
+            "    string mesaj = \"islem tamam\";\n",
+            "    // gecici kontrol\n",
+        };
+        const char *satir = satirlar[rastgele.sayi(4)];
+        int konum = rastgeleSatirBasi();
+        for (const char *p = satir; *p; ++p, ++konum) uygula(betik, "yazma", konum, 0, std::string(1, *p));
+        int geri = 1 + (int)rastgele.sayi(4);
+        for (int i = 0; i < geri; ++i) uygula(betik, "geri_silme", --konum, 1, std::string());
+    }
+
+    void blokYapistir(std::vector<Duzenleme> &betik) {
+        size_t boy = 512 + rastgele.sayi(4096);
+        size_t bas = rastgele.sayi(yapistirilacak.size() - boy);
+        uygula(betik, "yapistirma", rastgeleSatirBasi(), 0, yapistirilacak.substr(bas, boy));
+    }
+
+    void satirSil(std::vector<Duzenleme> &betik) {
+        int bas = rastgeleSatirBasi();
+        size_t son = kopya.find('\n', bas);
+        son = son == std::string::npos ? kopya.size() : son + 1;
+        if (son > (size_t)bas) uygula(betik, "satir_silme", bas, (int)(son - bas), std::string());
+    }
+
+    // Kapatılmamış bir yorum metnin geri kalanını yorum yapar; birkaç karakter
+    // yazıldıktan sonra "/*" geri silinir
+    void yorumAcKapat(std::vector<Duzenleme> &betik) {
+        int konum = rastgeleSatirBasi();
+        uygula(betik, "yorum_acma", konum, 0, "/*");
+        int yazilan = (int)rastgele.sayi(3);
+        for (int i = 0; i < yazilan; ++i) uygula(betik, "yazma", konum + 2 + i, 0, "a");
+        for (int i = yazilan - 1; i >= 0; --i) uygula(betik, "geri_silme", konum + 2 + i, 1, std::string());
+        uygula(betik, "yorum_kapatma", konum, 2, std::string());
+    }
+};
+
+double yuzdelik(const std::vector<double> &sirali, double oran) {
+    // En yakın sıra yöntemi
+    size_t sira = (size_t)std::ceil(oran * sirali.size());
+    return sirali[std::min(std::max<size_t>(sira, 1), sirali.size()) - 1];
+}
+
+int kullanim() {
+    std::fprintf(stderr,
+                 "kullanim: gecikme_bench [--dosya yol | --boyut bayt] [--betik dosya]\n"
+                 "                        [--betik-yaz dosya] [--oturum n] [--tohum n]\n"
+                 "                        [--butce ms] [--cikti dosya]\n");
+    return 2;
+}
+
+bool dosyaOku(const char *yol, std::string &icerik) {
+    FILE *f = std::fopen(yol, "rb");
+    if (!f) return false;
+    char blok[65536];
+    size_t n;
+    while ((n = std::fread(blok, 1, sizeof(blok), f)) > 0) icerik.append(blok, n);
+    std::fclose(f);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *dosyaYolu = nullptr, *betikYolu = nullptr, *betikYazYolu = nullptr, *ciktiYolu = nullptr;
+    size_t boyut = 4u << 20;
+    int oturum = 400;
+    uint64_t tohum = 1;
+    double butce = -1;
+    for (int i = 1; i < argc; ++i) {
+        std::string secenek = argv[i];
+        if (i + 1 >= argc) return kullanim();
+        const char *deger = argv[++i];
+        if (secenek == "--dosya") dosyaYolu = deger;
+        else if (secenek == "--boyut") boyut = (size_t)std::strtoull(deger, nullptr, 10);
+        else if (secenek == "--betik") betikYolu = deger;
+        else if (secenek == "--betik-yaz") betikYazYolu = deger;
+        else if (secenek == "--oturum") oturum = std::atoi(deger);
+        else if (secenek == "--tohum") tohum = std::strtoull(deger, nullptr, 10);
+        else if (secenek == "--butce") butce = std::atof(deger);
+        else if (secenek == "--cikti") ciktiYolu = deger;
+        else return kullanim();
+    }
+
+    std::string metin;
+    if (dosyaYolu) {
+        if (!dosyaOku(dosyaYolu, metin)) {
+            std::fprintf(stderr, "%s: okunamadi\n", dosyaYolu);
+            return 1;
+        }
+    } else {
+        KorpusAyarlari ayarlar;
+        ayarlar.boyut = boyut;
+        ayarlar.tohum = tohum;
+        metin = korpusUret(ayarlar);
+    }
+
+    std::vector<Duzenleme> betik;
+    if (betikYolu) {
+        int hataliSatir = 0;
+        if (!betikOku(betikYolu, betik, &hataliSatir)) {
+            if (hataliSatir) std::fprintf(stderr, "%s:%d: bozuk satir\n", betikYolu, hataliSatir);
+            else std::fprintf(stderr, "%s: okunamadi\n", betikYolu);
+            return 1;
+        }
+    } else {
+        BetikUretici uretici(metin, tohum);
+        for (int i = 0; i < oturum; ++i) uretici.oturumEkle(betik);
+    }
+    if (betikYazYolu) {
+        FILE *f = std::fopen(betikYazYolu, "w");
+        if (!f) {
+            std::fprintf(stderr, "%s: acilamadi\n", betikYazYolu);
+            return 1;
+        }
+        std::fprintf(f, "# tur\tkonum\tsilinen\teklenen\n");
+        duzenlemeYaz(f, Duzenleme{"yukle", 0, 0, metin});
+        for (const Duzenleme &d : betik) duzenlemeYaz(f, d);
+        std::fclose(f);
+    }
+
+    // Düzenleyicideki ile aynı bağlantılar; görünüm olmadığı için çizim yapılmaz
+    Fl_Text_Buffer *buffer = new Fl_Text_Buffer();
+    Belge belge;
+    TokenAkisi akis(belge);
+    SyntaxVurgulayici vurgulayici(buffer, &akis);
+    buffer->add_modify_callback(metin_degisti_cb, &vurgulayici);
+    buffer->text(metin.c_str());
+    vurgulayici.tokenize();
+    vurgulayici.vurgula();
+    vurgulayici.tamamla();
+
+    std::map<std::string, std::vector<double>> sureler;  // Türe göre milisaniye
+    size_t atlanan = 0;
+    for (const Duzenleme &d : betik) {
+        if (d.tur == "yukle") {
+            buffer->text(d.eklenen.c_str());
+            vurgulayici.tamamla();
+            continue;
+        }
+        if (d.konum + d.silinen > buffer->length()) {
+            ++atlanan;  // Betik bu metne uymuyor
+            continue;
+        }
+        auto bas = std::chrono::steady_clock::now();
+        if (d.silinen && !d.eklenen.empty()) {
+            buffer->replace(d.konum, d.konum + d.silinen, d.eklenen.data(), (int)d.eklenen.size());
+        } else if (d.silinen) {
+            buffer->remove(d.konum, d.konum + d.silinen);
+        } else if (!d.eklenen.empty()) {
+            buffer->insert(d.konum, d.eklenen.data(), (int)d.eklenen.size());
+        }
+        std::chrono::duration<double, std::milli> gecen = std::chrono::steady_clock::now() - bas;
+        sureler[d.tur].push_back(gecen.count());
+        // Düzenleyicide tuş vuruşları arasında boşta tamamlanan kısım; ölçüme girmez
+        vurgulayici.tamamla();
+    }
+
+    FILE *cikti = stdout;
+    if (ciktiYolu) {
+        cikti = std::fopen(ciktiYolu, "w");
+        if (!cikti) {
+            std::fprintf(stderr, "%s: acilamadi\n", ciktiYolu);
+            return 1;
+        }
+    }
+    bool butceAsildi = false;
+    std::fprintf(stderr, "metin: %.2f MB, %zu duzenleme, %zu atlanan\n", buffer->length() / (1024.0 * 1024.0),
+                 betik.size(), atlanan);
+    std::fprintf(stderr, "%-14s %8s %10s %10s %10s %10s\n", "tur", "adet", "p50 ms", "p95 ms", "p99 ms", "max ms");
+    std::fprintf(cikti, "{\"bytes\": %d, \"edits\": %zu, \"skipped\": %zu, \"budget_ms\": %.3f, \"types\": {",
+                 buffer->length(), betik.size(), atlanan, butce);
+    bool ilk = true;
+    for (auto &kayit : sureler) {
+        std::vector<double> &s = kayit.second;
+        std::sort(s.begin(), s.end());
+        double p50 = yuzdelik(s, 0.50), p95 = yuzdelik(s, 0.95), p99 = yuzdelik(s, 0.99), enFazla = s.back();
+        bool asti = butce >= 0 && p99 > butce;
+        butceAsildi = butceAsildi || asti;
+        std::fprintf(stderr, "%-14s %8zu %10.3f %10.3f %10.3f %10.3f%s\n", kayit.first.c_str(), s.size(), p50, p95,
+                     p99, enFazla, asti ? "  BUTCE ASILDI" : "");
+        std::fprintf(cikti,
+                     "%s\n  \"%s\": {\"count\": %zu, \"p50_ms\": %.4f, \"p95_ms\": %.4f, \"p99_ms\": %.4f, "
+                     "\"max_ms\": %.4f, \"over_budget\": %s}",
+                     ilk ? "" : ",", kayit.first.c_str(), s.size(), p50, p95, p99, enFazla, asti ? "true" : "false");
+        ilk = false;
+    }
+    std::fprintf(cikti, "\n}}\n");
+    if (cikti != stdout) std::fclose(cikti);
+    return butceAsildi ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+// İfade ayrıştırıcısı zorlama ölçümü
+// Makine üretimi ifadeleri farklı boyutlarda ayrıştırır ve token başına
+// süreyi yazdırır. Ayrıştırıcı özyinelemesiz olduğundan süre her şekilde
+// token sayısıyla doğrusal kalmalı, bir milyon iç içe parantez de çağrı
+// yığınını taşırmamalıdır. Aynı Parser ve ParseTree yeniden kullanıldığında
+// ilk ayrıştırmadan sonra bellek ayrılmaması beklenir (ayirma sütunu).
+//
+// Şekiller:
+//   zincir    a + b * c << d ...   bütün ikili operatörler, öncelikler karışık
+//   sol       ((((a + 1) * 2) ...  sola doğru iç içe parantez
+//   sag       a + (b * (c - ...))  sağa doğru iç içe parantez
+//   onek      - ! ~ * & ++ a       önek operatörü zinciri
+//   atama     a = b += c <<= ...   sağdan birleşen atama zinciri
+//   uclu      a ? b : c ? d : ...  iç içe üçlü işlem
+//   sonek     a[i](x, y).b->c++    çağrı, indeks ve üye erişimi zinciri
+//   karisik   rastgele ifade ağaçları; her deyim kırk token civarında
+//
+// Kullanım: ifade_bench [en_buyuk_token_sayisi]
+#include "../parser.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// operator new çağrılarını sayar
+size_t ayirmaSayisi = 0;
+
+// splitmix64; aynı tohum her platformda aynı ifadeleri üretir
+class Rastgele {
+public:
+    explicit Rastgele(uint64_t tohum) : durum(tohum) {}
+    uint64_t sonraki() {
+        uint64_t z = (durum += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // [0, n) aralığında bir sayı
+    uint32_t sayi(uint32_t n) { return (uint32_t)(((sonraki() >> 32) * n) >> 32); }
+    template <typename T, size_t N>
+    const char *sec(T (&dizi)[N]) { return dizi[sayi((uint32_t)N)]; }
+
+private:
+    uint64_t durum;
+};
+
+const char *const ikililer[] = {"*", "/", "%", "+", "-", "<<", ">>", "<", "<=", ">", ">=",
+                                "==", "!=", "&", "^", "|", "&&", "||"};
+const char *const atamalar[] = {"=", "+=", "-=", "*=", "/=", "%=", "<<=", ">>=", "&=", "^=", "|="};
+const char *const onekler[] = {"-", "+", "!", "~", "*", "&", "++", "--"};
+const char *const adlar[] = {"a", "b", "c", "deger", "sayac", "x", "y", "i", "n", "p"};
+
+// Her şekil, yaklaşık 'token' token'lık tek bir ifade deyimi üretir
+std::string zincir(size_t token, Rastgele &r) {
+    std::string s = "x = a";
+    for (size_t t = 0; t < token / 2; ++t) {
+        s += ' ';
+        s += r.sec(ikililer);
+        s += ' ';
+        s += r.sec(adlar);
+    }
+    return s + ";\n";
+}
+
+std::string sol(size_t token, Rastgele &r) {
+    size_t n = token / 4;
+    std::string s = "x = ";
+    s.append(n, '(');
+    s += 'a';
+    for (size_t t = 0; t < n; ++t) {
+        s += ' ';
+        s += r.sec(ikililer);
+        s += " 1)";
+    }
+    return s + ";\n";
+}
+
+std::string sag(size_t token, Rastgele &r) {
+    size_t n = token / 4;
+    std::string s = "x = ";
+    for (size_t t = 0; t < n; ++t) {
+        s += r.sec(adlar);
+        s += ' ';
+        s += r.sec(ikililer);
+        s += " (";
+    }
+    s += 'a';
+    s.append(n, ')');
+    return s + ";\n";
+}
+
+std::string onek(size_t token, Rastgele &r) {
+    std::string s = "x = ";
+    for (size_t t = 0; t < token; ++t) {
+        s += r.sec(onekler);
+        s += ' ';
+    }
+    return s + "a;\n";
+}
+
+std::string atama(size_t token, Rastgele &r) {
+    std::string s;
+    for (size_t t = 0; t < token / 2; ++t) {
+        s += r.sec(adlar);
+        s += ' ';
+        s += r.sec(atamalar);
+        s += ' ';
+    }
+    return s + "0;\n";
+}
+
+std::string uclu(size_t token, Rastgele &r) {
+    std::string s = "x = ";
+    for (size_t t = 0; t < token / 4; ++t) {
+        s += r.sec(adlar);
+        s += " ? ";
+        s += r.sec(adlar);
+        s += " : ";
+    }
+    return s + "0;\n";
+}
+
+std::string sonek(size_t token, Rastgele &r) {
+    std::string s = "x = a";
+    for (size_t t = 0; t < token / 4; ++t) {
+        switch (r.sayi(5)) {
+            case 0: s += "[i]"; break;
+            case 1: s += "(x, y)"; break;
+            case 2: s += ".b"; break;
+            case 3: s += "->c"; break;
+            default: s += "++"; break;
+        }
+    }
+    return s + ";\n";
+}
+
+// Rastgele bir ifade ağacı; derinlik üretecin kendi yığınını sınırlar
+void rastgeleIfade(std::string &s, Rastgele &r, int derinlik) {
+    if (derinlik == 0 || r.sayi(4) == 0) {
+        if (r.sayi(3) == 0) s += std::to_string(r.sayi(1000));
+        else s += r.sec(adlar);
+        return;
+    }
+    switch (r.sayi(9)) {
+        case 0:
+        case 1:
+        case 2:
+            rastgeleIfade(s, r, derinlik - 1);
+            s += ' ';
+            s += r.sec(ikililer);
+            s += ' ';
+            rastgeleIfade(s, r, derinlik - 1);
+            break;
+        case 3:
+            s += '(';
+            rastgeleIfade(s, r, derinlik - 1);
+            s += ')';
+            break;
+        case 4:
+            s += r.sec(onekler);
+            s += ' ';
+            rastgeleIfade(s, r, derinlik - 1);
+            break;
+        case 5:
+            rastgeleIfade(s, r, derinlik - 1);
+            s += " ? ";
+            rastgeleIfade(s, r, derinlik - 1);
+            s += " : ";
+            rastgeleIfade(s, r, derinlik - 1);
+            break;
+        case 6:
+            s += r.sec(adlar);
+            s += '(';
+            rastgeleIfade(s, r, derinlik - 1);
+            s += ", ";
+            rastgeleIfade(s, r, derinlik - 1);
+            s += ')';
+            break;
+        case 7:
+            s += r.sec(adlar);
+            s += r.sayi(2) ? "->" : ".";
+            s += r.sec(adlar);
+            s += '[';
+            rastgeleIfade(s, r, derinlik - 1);
+            s += ']';
+            break;
+        default:
+            s += r.sayi(2) ? "(int)" : "sizeof ";
+            rastgeleIfade(s, r, derinlik - 1);
+            break;
+    }
+}
+
+std::string karisik(size_t token, Rastgele &r) {
+    std::string s;
+    // Ortalama token uzunluğu boşluklarla birlikte 2,5 bayt civarındadır
+    while (s.size() < token * 5 / 2) {
+        s += r.sec(adlar);
+        s += ' ';
+        s += r.sec(atamalar);
+        s += ' ';
+        rastgeleIfade(s, r, 6);
+        s += ";\n";
+    }
+    return s;
+}
+
+struct Sekil {
+    const char *ad;
+    std::string (*uret)(size_t, Rastgele &);
+};
+
+} // namespace
+
+void *operator new(size_t boyut) {
+    ++ayirmaSayisi;
+    if (void *p = std::malloc(boyut ? boyut : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char **argv) {
+    size_t enBuyuk = argc > 1 ? (size_t)std::atol(argv[1]) : 1000000;
+    const Sekil sekiller[] = {{"zincir", zincir}, {"sol", sol},     {"sag", sag},     {"onek", onek},
+                              {"atama", atama},   {"uclu", uclu}, {"sonek", sonek}, {"karisik", karisik}};
+
+    std::printf("%-8s %10s %10s %12s %10s %10s %8s\n", "sekil", "token", "dugum", "sure (ms)", "ns/token", "bayt/token",
+                "ayirma");
+    for (const Sekil &sekil : sekiller) {
+        for (size_t hedef = 1000; hedef <= enBuyuk; hedef *= 10) {
+            Rastgele rastgele(hedef);
+            std::string kod = sekil.uret(hedef, rastgele);
+            std::vector<Token> tokenlar;
+            tokenizeMetin(kod.data(), kod.size(), tokenlar);
+
+            Parser parser;
+            ParseTree agac;
+            parser.parse(kod, tokenlar, agac);
+            // İlk ayrıştırma belleği ayırır; sonrakilerin en iyisi raporlanır
+            size_t ayirma0 = ayirmaSayisi;
+            double enIyi = 1e30;
+            for (int tur = 0; tur < 3; ++tur) {
+                auto bas = std::chrono::steady_clock::now();
+                parser.parse(kod, tokenlar, agac);
+                std::chrono::duration<double> gecen = std::chrono::steady_clock::now() - bas;
+                if (gecen.count() < enIyi) enIyi = gecen.count();
+            }
+            std::printf("%-8s %10zu %10zu %12.3f %10.1f %10.1f %8zu\n", sekil.ad, tokenlar.size(), agac.nodeCount(),
+                        enIyi * 1000, enIyi * 1e9 / tokenlar.size(), (double)agac.memoryUsage() / tokenlar.size(),
+                        ayirmaSayisi - ayirma0);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include "korpus.h"
+#include <algorithm>
+
+namespace {
+
+const char *const adlar[] = {"deger", "sayac", "toplam", "oran", "x", "y", "i", "n", "sonuc", "indeks",
+                             "uzunluk", "adim", "kalan", "fark", "ortalama", "hiz"};
+const char *const tipler[] = {"int", "float", "char", "string", "double", "bool"};
+const char *const donusTipleri[] = {"int", "float", "void", "string", "double"};
+const char *const operatorler[] = {"+", "-", "*", "/", "%", "<", ">", "==", "!=", "&&", "||"};
+const char *const kelimeler[] = {"degeri", "hesapla", "once", "sonra", "dongu", "sinir", "kontrol", "et",
+                                 "gecici", "tampon", "yeniden", "kullan", "eger", "sifir", "ise", "atla"};
+
+class Uretici {
+public:
+    Uretici(const KorpusAyarlari &a, std::string &k) : ayarlar(a), kod(k), durum(a.tohum) {}
+
+    void fonksiyon(int no) {
+        if (olasilik(ayarlar.yorumYogunlugu)) blokYorum(0);
+        kod += sec(donusTipleri);
+        kod += " islem";
+        kod += std::to_string(no);
+        kod += '(';
+        int parametre = (int)sayi(4);
+        for (int p = 0; p < parametre; ++p) {
+            if (p) kod += ", ";
+            kod += sec(tipler);
+            kod += ' ';
+            kod += adlar[p];
+        }
+        kod += ") {\n";
+        int hedef = std::max(1, ayarlar.fonksiyonBoyutu);
+        int deyimSayisi = hedef / 2 + (int)sayi((uint32_t)hedef + 1);
+        for (int d = 0; d < deyimSayisi; ++d) deyim(1, ayarlar.derinlik);
+        girinti(1);
+        kod += "return ";
+        ifade(2);
+        kod += ";\n}\n\n";
+    }
+
+private:
+    const KorpusAyarlari &ayarlar;
+    std::string &kod;
+    uint64_t durum;
+
+    // splitmix64
+    uint64_t sonraki() {
+        uint64_t z = (durum += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // [0, n) aralığında bir sayı
+    uint32_t sayi(uint32_t n) { return (uint32_t)(((sonraki() >> 32) * n) >> 32); }
+    bool olasilik(double p) { return (double)(sonraki() >> 11) * (1.0 / 9007199254740992.0) < p; }
+    template <typename T, size_t N>
+    const char *sec(T (&dizi)[N]) { return dizi[sayi((uint32_t)N)]; }
+
+    void girinti(int seviye) { kod.append((size_t)seviye * 4, ' '); }
+
+    void kelimeEkle(int adet) {
+        for (int k = 0; k < adet; ++k) {
+            kod += ' ';
+            kod += sec(kelimeler);
+        }
+    }
+
+    void satirYorumu(int seviye) {
+        girinti(seviye);
+        kod += "//";
+        kelimeEkle(3 + (int)sayi(8));
+        kod += '\n';
+    }
+
+    void blokYorum(int seviye) {
+        girinti(seviye);
+        kod += "/*";
+        int satir = 1 + (int)sayi(4);
+        for (int s = 0; s < satir; ++s) {
+            if (s) {
+                kod += '\n';
+                girinti(seviye);
+                kod += " *";
+            }
+            kelimeEkle(4 + (int)sayi(8));
+        }
+        kod += " */\n";
+    }
+
+    void metinSabiti() {
+        kod += '"';
+        int adet = 1 + (int)sayi(6);
+        for (int k = 0; k < adet; ++k) {
+            if (k) kod += ' ';
+            kod += sec(kelimeler);
+        }
+        switch (sayi(4)) {
+            case 0: kod += "\\n"; break;
+            case 1: kod += " \\\"tamam\\\""; break;
+            default: break;
+        }
+        kod += '"';
+    }
+
+    void terim(int kalan) {
+        uint32_t secim = sayi(10);
+        if (olasilik(ayarlar.metinYogunlugu)) {
+            metinSabiti();
+        } else if (secim < 5) {
+            kod += sec(adlar);
+        } else if (secim < 7) {
+            kod += std::to_string(sayi(1000));
+        } else if (secim < 8) {
+            kod += std::to_string(sayi(100));
+            kod += '.';
+            kod += std::to_string(sayi(100));
+        } else if (secim < 9) {
+            kod += '\'';
+            kod += (char)('a' + sayi(26));
+            kod += '\'';
+        } else if (kalan > 0) {
+            kod += '(';
+            ifade(kalan - 1);
+            kod += ')';
+        } else {
+            kod += sec(adlar);
+        }
+    }
+
+    void ifade(int kalan) {
+        terim(kalan);
+        int islem = (int)sayi(4);
+        for (int k = 0; k < islem; ++k) {
+            kod += ' ';
+            kod += sec(operatorler);
+            kod += ' ';
+            terim(kalan);
+        }
+    }
+
+    void blok(int seviye, int kalanDerinlik) {
+        kod += " {\n";
+        int adet = 1 + (int)sayi(3);
+        for (int k = 0; k < adet; ++k) deyim(seviye + 1, kalanDerinlik - 1);
+        girinti(seviye);
+        kod += '}';
+    }
+
+    void deyim(int seviye, int kalanDerinlik) {
+        if (olasilik(ayarlar.yorumYogunlugu)) {
+            if (sayi(3) == 0) blokYorum(seviye);
+            else satirYorumu(seviye);
+        }
+        girinti(seviye);
+        uint32_t secim = sayi(kalanDerinlik > 0 ? 10 : 6);
+        if (secim < 3) {
+            kod += sec(tipler);
+            kod += ' ';
+            kod += sec(adlar);
+            kod += " = ";
+            ifade(2);
+            kod += ";\n";
+        } else if (secim < 6) {
+            kod += sec(adlar);
+            kod += " = ";
+            ifade(2);
+            kod += ";\n";
+        } else if (secim < 8) {
+            kod += "if (";
+            ifade(1);
+            kod += ')';
+            blok(seviye, kalanDerinlik);
+            if (sayi(2) == 0) {
+                kod += " else";
+                blok(seviye, kalanDerinlik);
+            }
+            kod += '\n';
+        } else if (secim < 9) {
+            kod += "while (";
+            ifade(1);
+            kod += ')';
+            blok(seviye, kalanDerinlik);
+            kod += '\n';
+        } else {
+            const char *ad = sec(adlar);
+            kod += "for (";
+            kod += ad;
+            kod += " = 0; ";
+            kod += ad;
+            kod += " < ";
+            kod += sec(adlar);
+            kod += "; ";
+            kod += ad;
+            kod += " = ";
+            kod += ad;
+            kod += " + 1)";
+            blok(seviye, kalanDerinlik);
+            kod += '\n';
+        }
+    }
+};
+
+} // namespace
+
+std::string korpusUret(const KorpusAyarlari &ayarlar) {
+    std::string kod;
+    kod.reserve(ayarlar.boyut + 4096);
+    Uretici uretici(ayarlar, kod);
+    for (int no = 0; kod.size() < ayarlar.boyut; ++no) uretici.fonksiyon(no);
+    if (kod.size() > ayarlar.boyut) {
+        size_t son = kod.rfind('\n', ayarlar.boyut - 1);
+        kod.resize(son == std::string::npos ? 0 : son + 1);
+    }
+    return kod;
+}
@@ -0,0 +1,25 @@
+#ifndef KORPUS_H
+#define KORPUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Ölçümler için sentetik C benzeri kaynak üreticisi
+// Aynı ayarlar ve tohum her platformda bayt bayt aynı metni üretir; rastgele
+// sayılar standart kütüphanenin dağılımlarına bağlı olmadan splitmix64 ile
+// üretilir. Üretilen kod parser'ın tanıdığı yapılardan oluşur.
+struct KorpusAyarlari {
+    size_t boyut = 1u << 20;        // Hedef boyut (bayt); metin bu boyuta kadar üretilip kesilir
+    double yorumYogunlugu = 0.15;   // Bir deyimin önüne yorum gelme olasılığı [0, 1]
+    double metinYogunlugu = 0.10;   // Bir ifadenin metin sabiti içerme olasılığı [0, 1]
+    int derinlik = 3;               // İç içe if/while/for bloklarının en fazla derinliği
+    int fonksiyonBoyutu = 12;       // Fonksiyon başına ortalama deyim sayısı
+    uint64_t tohum = 1;
+};
+
+// Ayarlara göre kaynak metni üretir; sonuç en fazla ayarlar.boyut bayttır
+// ve yarım kalan son satır atılır
+std::string korpusUret(const KorpusAyarlari &ayarlar);
+
+#endif
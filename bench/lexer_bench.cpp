@@ -0,0 +1,204 @@
+// Lexer hız ölçümü
+// Eski regex tabanlı tokenize() ile tek geçişli Lexer'ı aynı sentetik
+// C kodu üzerinde karşılaştırır ve MB/s cinsinden hızlarını yazdırır.
+// Ardından tarama çekirdeklerinin (skaler, SSE2, AVX2) hızını olağan,
+// yorum ağırlıklı ve metin ağırlıklı kaynaklar üzerinde ölçer.
+//
+// Kullanım: lexer_bench [satir_sayisi]
+#include "../lexer.h"
+#include "../tarama.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Eski SyntaxVurgulayici::tokenize() uygulamasının birebir kopyası
+// Yalnızca karşılaştırma için tutulur
+class RegexLexer {
+    std::vector<std::string> anahtarKelimeler = {"if", "else", "while", "for", "return", "int", "float", "void", "char", "string"};
+    std::regex anahtarKelimeRegex;
+    std::regex tanimlayiciRegex;
+    std::regex sayiRegex;
+    std::regex operatorRegex;
+    std::regex metinRegex;
+    std::regex karakterRegex;
+    std::regex yorumRegex;
+
+    void tara(const std::string &metin, const std::regex &desen, TokenTipi tip,
+              std::vector<Token> &tokenlar, std::vector<std::pair<int, int>> *araliklar) {
+        for (std::sregex_iterator i(metin.begin(), metin.end(), desen), son; i != son; ++i) {
+            int baslangic = (int)i->position();
+            int bitis = baslangic + (int)i->length();
+            if (araliklar) araliklar->push_back({baslangic, bitis});
+            tokenlar.push_back(Token{baslangic, bitis, tip});
+        }
+    }
+
+public:
+    RegexLexer() {
+        std::string desen;
+        for (size_t i = 0; i < anahtarKelimeler.size(); ++i) {
+            if (i != 0) desen += "|";
+            desen += anahtarKelimeler[i];
+        }
+        anahtarKelimeRegex = std::regex("\\b(" + desen + ")\\b");
+        tanimlayiciRegex = std::regex("[a-zA-Z_]\\w*");
+        sayiRegex = std::regex("\\b\\d+(\\.\\d+)?\\b");
+        operatorRegex = std::regex("[\\+\\-\\*/%=&|<>!]");
+        metinRegex = std::regex("\"(?:[^\"\\\\]|\\\\.)*\"");
+        karakterRegex = std::regex("'(?:[^'\\\\]|\\\\.)'");
+        yorumRegex = std::regex("(//[^\\n]*)|(/\\*[\\s\\S]*?\\*/)");
+    }
+
+    void tokenize(const std::string &metin, std::vector<Token> &tokenlar) {
+        tokenlar.clear();
+        std::vector<std::pair<int, int>> atlanacaklar;
+        tara(metin, metinRegex, METIN, tokenlar, &atlanacaklar);
+        tara(metin, karakterRegex, KARAKTER, tokenlar, &atlanacaklar);
+        tara(metin, yorumRegex, YORUM, tokenlar, &atlanacaklar);
+        auto icindeMi = [&atlanacaklar](int baslangic, int bitis) {
+            for (const auto &a : atlanacaklar) {
+                if (baslangic >= a.first && bitis <= a.second) return true;
+            }
+            return false;
+        };
+        std::vector<Token> adaylar;
+        tara(metin, anahtarKelimeRegex, ANAHTAR_KELIME, adaylar, nullptr);
+        tara(metin, sayiRegex, SAYI, adaylar, nullptr);
+        tara(metin, operatorRegex, OPERATOR, adaylar, nullptr);
+        for (std::sregex_iterator i(metin.begin(), metin.end(), tanimlayiciRegex), son; i != son; ++i) {
+            if (!std::regex_match(i->str(), anahtarKelimeRegex)) {
+                int baslangic = (int)i->position();
+                adaylar.push_back(Token{baslangic, baslangic + (int)i->length(), TANIMLAYICI});
+            }
+        }
+        for (const Token &t : adaylar) {
+            if (!icindeMi(t.baslangic, t.bitis)) tokenlar.push_back(t);
+        }
+        std::sort(tokenlar.begin(), tokenlar.end(),
+                  [](const Token &a, const Token &b) { return a.baslangic < b.baslangic; });
+    }
+};
+
+// main() içindeki örnek koda benzeyen deterministik bir kaynak üretir
+std::string ornekKodUret(int satirSayisi) {
+    std::string kod;
+    int satir = 0;
+    for (int f = 0; satir < satirSayisi; ++f) {
+        std::string ad = "hesapla" + std::to_string(f);
+        kod += "/* " + ad + " fonksiyonu\n   otomatik uretildi */\n";
+        kod += "string " + ad + "(int x, float y) {\n";
+        kod += "    // Pozitif mi kontrol et\n";
+        kod += "    if (x > 0 && y < 100.0) {\n";
+        kod += "        string sonuc = \"Pozitif \\\"deger\\\"\";\n";
+        kod += "        char c = '\\n';\n";
+        kod += "        return sonuc;\n";
+        kod += "    }\n";
+        kod += "    while (x != 0) {\n";
+        kod += "        x = x - 1;\n";
+        kod += "        y = y * 2.0 + " + std::to_string(f % 97) + ";\n";
+        kod += "    }\n";
+        kod += "    return \"Bitti\";\n";
+        kod += "}\n\n";
+        satir += 16;
+    }
+    return kod;
+}
+
+// Uzun yorum bloklarıyla belgelenmiş, girintili kod üretir
+std::string yorumluKodUret(int satirSayisi) {
+    std::string kod;
+    int satir = 0;
+    for (int f = 0; satir < satirSayisi; ++f) {
+        kod += "/*\n";
+        for (int i = 0; i < 8; ++i) {
+            kod += " * hesapla" + std::to_string(f) + " fonksiyonunun ayrintili aciklamasi, satir " +
+                   std::to_string(i) + "; parametreler ve donus degeri burada anlatilir.\n";
+        }
+        kod += " */\n";
+        kod += "int hesapla" + std::to_string(f) + "(int x) {\n";
+        kod += "                // girintili tek satirlik bir yorum, kodun ne yaptigini anlatir\n";
+        kod += "                return x * " + std::to_string(f % 97) + ";\n";
+        kod += "}\n\n";
+        satir += 15;
+    }
+    return kod;
+}
+
+// Uzun metin sabitleri içeren tablolar üretir
+std::string metinliKodUret(int satirSayisi) {
+    std::string kod;
+    for (int i = 0; i < satirSayisi; ++i) {
+        kod += "    mesajlar[" + std::to_string(i) + "] = \"Kullaniciya gosterilen uzun bir hata mesaji, "
+               "numara " + std::to_string(i) + ": \\\"dosya\\\" bulunamadi ya da okunamadi\";\n";
+    }
+    return kod;
+}
+
+template <typename F>
+double sure(F &&islem, int tekrar) {
+    auto bas = std::chrono::steady_clock::now();
+    for (int i = 0; i < tekrar; ++i) islem();
+    std::chrono::duration<double> gecen = std::chrono::steady_clock::now() - bas;
+    return gecen.count() / tekrar;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int satirSayisi = argc > 1 ? std::atoi(argv[1]) : 20000;
+    std::string kod = ornekKodUret(satirSayisi);
+    double mb = kod.size() / (1024.0 * 1024.0);
+    std::vector<Token> tokenlar;
+
+    double yeniSure = sure([&] {
+        tokenlar.clear();
+        tokenizeMetin(kod.data(), kod.size(), tokenlar);
+    }, 10);
+    size_t yeniSayi = tokenlar.size();
+
+    RegexLexer eski;
+    double eskiSure = sure([&] { eski.tokenize(kod, tokenlar); }, 1);
+    size_t eskiSayi = tokenlar.size();
+
+    std::printf("metin: %d satir, %.2f MB\n", satirSayisi, mb);
+    std::printf("%-8s %12s %12s %10s\n", "lexer", "sure (ms)", "MB/s", "token");
+    std::printf("%-8s %12.2f %12.2f %10zu\n", "regex", eskiSure * 1000, mb / eskiSure, eskiSayi);
+    std::printf("%-8s %12.2f %12.2f %10zu\n", "tek-gecis", yeniSure * 1000, mb / yeniSure, yeniSayi);
+    std::printf("hizlanma: %.1fx\n", eskiSure / yeniSure);
+
+    // Tarama çekirdekleri
+    struct Ornek {
+        const char *ad;
+        std::string kod;
+    };
+    Ornek ornekler[] = {
+        {"olagan", kod},
+        {"yorumlu", yorumluKodUret(satirSayisi)},
+        {"metinli", metinliKodUret(satirSayisi)},
+    };
+    const char *seviyeAdlari[] = {"skaler", "sse2", "avx2"};
+    TaramaSeviyesi enIyi = desteklenenTaramaSeviyesi();
+    std::printf("\n%-8s", "kaynak");
+    for (int s = TS_SKALER; s <= enIyi; ++s) std::printf(" %10s", seviyeAdlari[s]);
+    std::printf("   (MB/s)\n");
+    for (const Ornek &o : ornekler) {
+        std::printf("%-8s", o.ad);
+        for (int s = TS_SKALER; s <= enIyi; ++s) {
+            taramaSeviyesiAyarla((TaramaSeviyesi)s);
+            double t = sure([&] {
+                tokenlar.clear();
+                tokenizeMetin(o.kod.data(), o.kod.size(), tokenlar);
+            }, 10);
+            std::printf(" %10.1f", o.kod.size() / (1024.0 * 1024.0) / t);
+        }
+        std::printf("\n");
+    }
+    taramaSeviyesiAyarla(enIyi);
+    return 0;
+}
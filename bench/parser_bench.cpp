@@ -0,0 +1,245 @@
+// Parser hız ve bellek ölçümü
+// Sentetik C kodunu ayrıştırır; saniyede oluşturulan düğüm sayısını ve
+// düğüm başına ayrılan belleği yazdırır. Aynı ParseTree birden çok kez
+// kullanıldığında ilk ayrıştırmadan sonra bellek ayrılmaması beklenir.
+// Ardından ortadaki bir fonksiyonun gövdesine art arda satır ekleyip
+// silerek artımlı ayrıştırmanın düzenleme başına süresini ölçer. Son
+// olarak artımlı ayrıştırmanın sonucunu bilinen zor düzenlemelerde ve
+// iptal edilen bir baştan kurulumdan sonra tam ayrıştırmayla karşılaştırır;
+// fark varsa 1 ile çıkar.
+//
+// Kullanım: parser_bench [satir_sayisi]
+#include "../parser.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// operator new çağrılarını sayar
+size_t ayrilanBayt = 0;
+size_t ayirmaSayisi = 0;
+
+// Bellekteki bir metni artımlı lexer'a sunar
+class StringKaynagi : public MetinKaynagi {
+public:
+    std::string metin;
+    size_t uzunluk() const override { return metin.size(); }
+    void oku(size_t baslangic, size_t bitis, std::string &hedef) const override {
+        hedef.assign(metin, baslangic, bitis - baslangic);
+    }
+};
+
+// Parser'ın tanıdığı yapılardan oluşan deterministik bir kaynak üretir
+std::string ornekKodUret(int satirSayisi) {
+    std::string kod;
+    int satir = 0;
+    for (int f = 0; satir < satirSayisi; ++f) {
+        std::string ad = "hesapla" + std::to_string(f);
+        kod += "/* " + ad + " */\n";
+        kod += "string " + ad + "(int x, float y) {\n";
+        kod += "    int a = x * 2 + y / 3 - 1;\n";
+        kod += "    if (x) {\n";
+        kod += "        string sonuc = \"Pozitif\";\n";
+        kod += "        return sonuc;\n";
+        kod += "    }\n";
+        kod += "    while (x) {\n";
+        kod += "        x = x - 1;\n";
+        kod += "        y = y * 2.0 + " + std::to_string(f % 97) + ";\n";
+        kod += "    }\n";
+        kod += "    for (i = 0; i; i = i + 1) {\n";
+        kod += "        a = (a + i) * (y - 1);\n";
+        kod += "    }\n";
+        kod += "    return \"Bitti\";\n";
+        kod += "}\n\n";
+        satir += 17;
+    }
+    return kod;
+}
+
+// Artımlı ayrıştırmanın tam ayrıştırmadan ayrıldığı bulunmuş düzenlemeler
+// Her durumda metindeki ilk 'eski' parçası 'yeni' ile değiştirilir
+struct ArtimliDurum {
+    const char *metin;
+    const char *eski;
+    const char *yeni;
+};
+const ArtimliDurum artimliDurumlar[] = {
+    // Tipten sonra '(' gelip gelmediğine ileriye bakılarak karar verilir;
+    // yorum, bakılan token'ı öğenin sonraki token'ının ötesine taşır
+    {"int else //c\n(x);\n", "(", ")"},
+    {"int a; int f //c\n(int x) { return x; }\n", "(", ";"},
+    {"int f /* */ x;\nint g;\n", "x", "("},
+};
+
+// Düzenlemeden sonra artımlı ve tam ayrıştırmanın ağaçları aynı mı
+// Düğüm özetleri konumdan bağımsız olduğundan kökün özeti bütün ağacı karşılaştırır
+bool artimliTutarli(Parser &parser, const ArtimliDurum &durum) {
+    StringKaynagi kaynak;
+    kaynak.metin = durum.metin;
+    TokenDeposu depo;
+    ArtimliLexer lexer(depo);
+    lexer.tamamen(kaynak);
+    std::vector<Token> tokenlar;
+    depo.kopyala(tokenlar);
+    ParseTree artimli, tam;
+    parser.parse(kaynak.metin, tokenlar, artimli);
+
+    size_t konum = kaynak.metin.find(durum.eski);
+    size_t silinen = std::strlen(durum.eski), eklenen = std::strlen(durum.yeni);
+    kaynak.metin.replace(konum, silinen, durum.yeni);
+    DegisimAraligi degisim = lexer.guncelle(kaynak, (int)konum, (int)eklenen, (int)silinen);
+    depo.kopyala(tokenlar);
+    parser.reparse(kaynak.metin, tokenlar, degisim, artimli);
+    parser.parse(kaynak.metin, tokenlar, tam);
+    return artimli.hash(artimli.root()) == tam.hash(tam.root());
+}
+
+// Çöp sınırı aşılınca reparse() ağacı baştan kurar; bu kurulum iptal
+// edilirse ağaçta yalnızca ilk öğeler kalır. Arka plan ayrıştırıcısı gibi
+// iptal edilen düzenleme sonrakiyle birleştirilip yeniden ayrıştırılır ve
+// sonuç tam ayrıştırmayla karşılaştırılır.
+bool iptalSonrasiTutarli(Parser &parser) {
+    StringKaynagi kaynak;
+    kaynak.metin = ornekKodUret(400 * 17);
+    TokenDeposu depo;
+    ArtimliLexer lexer(depo);
+    lexer.tamamen(kaynak);
+    std::vector<Token> tokenlar;
+    depo.kopyala(tokenlar);
+    ParseTree artimli, tam;
+    parser.parse(kaynak.metin, tokenlar, artimli);
+
+    // Bir satırı ekleyip silerek çöpü sınıra kadar biriktir
+    const std::string satir = "        a = a + 1;\n";
+    int konum = (int)kaynak.metin.find("    while", kaynak.metin.size() / 2);
+    for (int i = 0;; ++i) {
+        ParseTreeImage img = artimli.image();
+        if (img.garbage * 2 > img.nodeCount + img.childIdCount) break;
+        DegisimAraligi degisim;
+        if (i % 2 == 0) {
+            kaynak.metin.insert(konum, satir);
+            degisim = lexer.guncelle(kaynak, konum, (int)satir.size(), 0);
+        } else {
+            kaynak.metin.erase(konum, satir.size());
+            degisim = lexer.guncelle(kaynak, konum, 0, (int)satir.size());
+        }
+        depo.kopyala(tokenlar);
+        parser.reparse(kaynak.metin, tokenlar, degisim, artimli);
+    }
+
+    // Sayaç nesilden farklı olduğu için baştan kurulum ilk denetimde kesilir
+    std::atomic<unsigned long> sayac(1);
+    parser.setCancellation(&sayac, 0);
+    // Düzenlemeler ağaçta kalan ilk öğelere denk gelir ve uzunluğu değiştirmez;
+    // artımlı ayrıştırma bu öğelerden birinde yakınsar
+    int bas = (int)kaynak.metin.find("x * 2");
+    kaynak.metin.replace(bas + 4, 1, "3");
+    DegisimAraligi iptal = lexer.guncelle(kaynak, bas + 4, 1, 1);
+    depo.kopyala(tokenlar);
+    parser.reparse(kaynak.metin, tokenlar, iptal, artimli);
+    parser.setCancellation(nullptr, 0);
+    if (!parser.cancelled()) return false;
+
+    int harf = (int)kaynak.metin.find("while", bas);
+    kaynak.metin.replace(harf, 1, "W");
+    DegisimAraligi degisim = lexer.guncelle(kaynak, harf, 1, 1);
+    depo.kopyala(tokenlar);
+    parser.reparse(kaynak.metin, tokenlar, degisimleriBirlestir(iptal, degisim), artimli);
+    parser.parse(kaynak.metin, tokenlar, tam);
+    return artimli.topLevelItems().size() == tam.topLevelItems().size() &&
+           artimli.hash(artimli.root()) == tam.hash(tam.root());
+}
+
+} // namespace
+
+void *operator new(size_t boyut) {
+    ayrilanBayt += boyut;
+    ++ayirmaSayisi;
+    if (void *p = std::malloc(boyut ? boyut : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char **argv) {
+    int satirSayisi = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::string kod = ornekKodUret(satirSayisi);
+    std::vector<Token> tokenlar;
+    tokenizeMetin(kod.data(), kod.size(), tokenlar);
+
+    Parser parser;
+    ParseTree agac;
+    std::printf("metin: %d satir, %.2f MB, %zu token\n", satirSayisi, kod.size() / (1024.0 * 1024.0), tokenlar.size());
+    std::printf("%-6s %12s %14s %12s %12s\n", "tur", "sure (ms)", "dugum/s", "bayt/dugum", "ayirma");
+    for (int tur = 0; tur < 5; ++tur) {
+        size_t bayt0 = ayrilanBayt, ayirma0 = ayirmaSayisi;
+        auto bas = std::chrono::steady_clock::now();
+        parser.parse(kod, tokenlar, agac);
+        std::chrono::duration<double> gecen = std::chrono::steady_clock::now() - bas;
+        size_t dugum = agac.nodeCount();
+        std::printf("%-6d %12.2f %14.0f %12.1f %12zu\n", tur, gecen.count() * 1000, dugum / gecen.count(),
+                    (double)(ayrilanBayt - bayt0) / dugum, ayirmaSayisi - ayirma0);
+    }
+    std::printf("dugum: %zu, agac bellegi: %.1f bayt/dugum\n", agac.nodeCount(), (double)agac.memoryUsage() / agac.nodeCount());
+
+    // Artımlı ayrıştırma: metnin ortasındaki bir satıra ifade ekle, sonra sil
+    StringKaynagi kaynak;
+    kaynak.metin = kod;
+    TokenDeposu depo;
+    std::vector<Token> artimliTokenlar;
+    ArtimliLexer lexer(depo);
+    lexer.tamamen(kaynak);
+    depo.kopyala(artimliTokenlar);
+    parser.parse(kaynak.metin, artimliTokenlar, agac);
+    const std::string eklenen = "        a = a + 1;\n";
+    int konum = (int)kaynak.metin.find("    while", kaynak.metin.size() / 2);
+    const int duzenlemeSayisi = 1000;
+    double toplam = 0, enUzun = 0;
+    for (int i = 0; i < duzenlemeSayisi; ++i) {
+        DegisimAraligi degisim;
+        if (i % 2 == 0) {
+            kaynak.metin.insert(konum, eklenen);
+            degisim = lexer.guncelle(kaynak, konum, (int)eklenen.size(), 0);
+        } else {
+            kaynak.metin.erase(konum, eklenen.size());
+            degisim = lexer.guncelle(kaynak, konum, 0, (int)eklenen.size());
+        }
+        // Parser düz token dizisini okur; arka plan işçisindeki gibi açılım süreye katılmaz
+        depo.kopyala(artimliTokenlar);
+        auto bas = std::chrono::steady_clock::now();
+        parser.reparse(kaynak.metin, artimliTokenlar, degisim, agac);
+        std::chrono::duration<double> gecen = std::chrono::steady_clock::now() - bas;
+        toplam += gecen.count();
+        if (gecen.count() > enUzun) enUzun = gecen.count();
+    }
+    std::printf("artimli: %d duzenleme, ortalama %.3f ms, en uzun %.2f ms (sikistirma dahil), %zu ust duzey oge\n",
+                duzenlemeSayisi, toplam / duzenlemeSayisi * 1000, enUzun * 1000, agac.topLevelItems().size());
+
+    // Artımlı sonuç tam ayrıştırmayla aynı olmalı
+    int fark = 0;
+    ParseTree tam;
+    parser.parse(kaynak.metin, artimliTokenlar, tam);
+    if (agac.hash(agac.root()) != tam.hash(tam.root())) {
+        std::printf("fark: art arda duzenlemelerden sonraki agac\n");
+        ++fark;
+    }
+    const size_t durumSayisi = sizeof(artimliDurumlar) / sizeof(artimliDurumlar[0]);
+    for (size_t i = 0; i < durumSayisi; ++i) {
+        if (!artimliTutarli(parser, artimliDurumlar[i])) {
+            std::printf("fark: durum %zu (\"%s\" -> \"%s\")\n", i, artimliDurumlar[i].eski, artimliDurumlar[i].yeni);
+            ++fark;
+        }
+    }
+    if (!iptalSonrasiTutarli(parser)) {
+        std::printf("fark: iptal edilen bastan kurulumdan sonraki agac\n");
+        ++fark;
+    }
+    std::printf("dogrulama: %zu durum, %d fark\n", durumSayisi + 2, fark);
+    return fark ? 1 : 0;
+}
@@ -0,0 +1,748 @@
+// Arayüzsüz lexer/parser aracı
+// Verilen dosyaları FLTK olmadan token'lara ayırıp ayrıştırır; token'ları ve
+// sözdizimi ağacını JSON (dosya başına bir satır) veya ikili biçimde yazar.
+// Dizin verilirse altındaki bütün C/C++ kaynakları bütün çekirdeklerde işlenir.
+//
+// Kullanım: syntax_cli [--format json|binary] [--tokens] [--ast] [--stats] [--cache dizin] [--find ad]... [-j N] [-o cikti] yol...
+// --tokens ve --ast verilmezse ikisi de yazılır. --cache verilirse token'lar ve
+// ağaç içerik özetiyle o dizinde saklanır; değişmemiş dosyalar yeniden
+// lexlenip ayrıştırılmaz, çıktı doğrudan belleğe eşlenen önbellekten yazılır.
+// --find verilirse bütün dosyaların tanım ve kullanımları tek bir çapraz
+// başvuru dizininde toplanır; dosyalar bitince her ad için tanımları ve
+// kullanımları bir JSON satırı olarak yazılır. --tokens ve --ast verilmezse
+// yalnızca bu satırlar yazılır.
+#include "lexer.h"
+#include "parser.h"
+#include "work_pool.h"
+#include "dosya_girdisi.h"
+#include "onbellek.h"
+#include "symbol_index.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+const char *tokenTipiAdi(TokenTipi tip) {
+    switch (tip) {
+        case ANAHTAR_KELIME: return "ANAHTAR_KELIME";
+        case TANIMLAYICI: return "TANIMLAYICI";
+        case SAYI: return "SAYI";
+        case OPERATOR: return "OPERATOR";
+        case METIN: return "METIN";
+        case KARAKTER: return "KARAKTER";
+        case YORUM: return "YORUM";
+        case BOSLUK: return "BOSLUK";
+        case NOKTALAMA: return "NOKTALAMA";
+        default: return "BILINMEYEN";
+    }
+}
+
+const char *dugumTipiAdi(NodeType tip) {
+    switch (tip) {
+        case PROGRAM: return "PROGRAM";
+        case FUNCTION_DEF: return "FUNCTION_DEF";
+        case VARIABLE_DECL: return "VARIABLE_DECL";
+        case PARAM_LIST: return "PARAM_LIST";
+        case PARAM: return "PARAM";
+        case STATEMENT: return "STATEMENT";
+        case IF_STATEMENT: return "IF_STATEMENT";
+        case WHILE_STATEMENT: return "WHILE_STATEMENT";
+        case FOR_STATEMENT: return "FOR_STATEMENT";
+        case RETURN_STATEMENT: return "RETURN_STATEMENT";
+        case EXPRESSION: return "EXPRESSION";
+        case BINARY_EXPR: return "BINARY_EXPR";
+        case UNARY_EXPR: return "UNARY_EXPR";
+        case ASSIGNMENT_EXPR: return "ASSIGNMENT_EXPR";
+        case LITERAL: return "LITERAL";
+        case IDENTIFIER: return "IDENTIFIER";
+        case TYPE: return "TYPE";
+        case BLOCK_STATEMENT: return "BLOCK_STATEMENT";
+        case CONDITIONAL_EXPR: return "CONDITIONAL_EXPR";
+        case CALL_EXPR: return "CALL_EXPR";
+        case INDEX_EXPR: return "INDEX_EXPR";
+        case MEMBER_EXPR: return "MEMBER_EXPR";
+        case POSTFIX_EXPR: return "POSTFIX_EXPR";
+        case CAST_EXPR: return "CAST_EXPR";
+        default: return "UNKNOWN";
+    }
+}
+
+// Çıktı dosyasına tamponlu yazar
+// Her iş parçacığının kendi yazıcısı vardır; tampon yalnızca kayıt sınırlarında
+// ve kilit altında boşaltılır, böylece farklı dosyaların kayıtları karışmaz.
+class Yazici {
+public:
+    Yazici(FILE *dosya, std::mutex *ciktiKilidi) : hedef(dosya), kilit(*ciktiKilidi, std::defer_lock) {}
+    ~Yazici() { bosalt(); }
+
+    void yaz(std::string_view s) { tampon.append(s.data(), s.size()); }
+    void yaz(char c) { tampon.push_back(c); }
+    void sayi(uint64_t n) {
+        char b[24];
+        int u = std::snprintf(b, sizeof(b), "%llu", (unsigned long long)n);
+        tampon.append(b, u);
+    }
+    // JSON metni olarak tırnaklı ve kaçışlı yazar
+    void jsonMetni(std::string_view s) {
+        yaz('"');
+        for (unsigned char c : s) {
+            switch (c) {
+                case '"': yaz("\\\""); break;
+                case '\\': yaz("\\\\"); break;
+                case '\n': yaz("\\n"); break;
+                case '\r': yaz("\\r"); break;
+                case '\t': yaz("\\t"); break;
+                default:
+                    if (c < 0x20) {
+                        char b[8];
+                        std::snprintf(b, sizeof(b), "\\u%04x", c);
+                        yaz(b);
+                    } else {
+                        yaz((char)c);
+                    }
+            }
+        }
+        yaz('"');
+    }
+    // İkili biçim için küçük sonlu (little-endian) tam sayılar
+    void u8(uint8_t n) { yaz((char)n); }
+    void u32(uint32_t n) {
+        char b[4] = {(char)n, (char)(n >> 8), (char)(n >> 16), (char)(n >> 24)};
+        tampon.append(b, 4);
+    }
+    void u64(uint64_t n) {
+        u32((uint32_t)n);
+        u32((uint32_t)(n >> 32));
+    }
+    // Kayıt ortasında tampon dolduysa boşaltır
+    // Kaydın geri kalanı da bütün olarak yazılsın diye çıktı kilidi kayıt
+    // bitene kadar tutulur; böylece akış halindeki büyük kayıtlar belleğe sığar
+    void araBosalt() {
+        if (tampon.size() < TAMPON_SINIRI) return;
+        if (!kilit.owns_lock()) kilit.lock();
+        yazVeTemizle();
+    }
+    // Bir kayıt tamamlandı; tampon dolduysa boşaltılır
+    void kayitBitti() {
+        if (kilit.owns_lock()) {
+            yazVeTemizle();
+            kilit.unlock();
+        } else if (tampon.size() >= TAMPON_SINIRI) {
+            bosalt();
+        }
+    }
+    void bosalt() {
+        if (tampon.empty()) return;
+        if (kilit.owns_lock()) {
+            yazVeTemizle();
+        } else {
+            std::lock_guard<std::mutex> lock(*kilit.mutex());
+            yazVeTemizle();
+        }
+    }
+
+private:
+    static const size_t TAMPON_SINIRI = 1 << 16;
+    FILE *hedef;
+    std::unique_lock<std::mutex> kilit;  // Çıktı kilidi; yalnızca kayıt ortasında boşaltırken tutulur
+    std::string tampon;
+
+    void yazVeTemizle() {
+        std::fwrite(tampon.data(), 1, tampon.size(), hedef);
+        tampon.clear();
+    }
+};
+
+struct Secenekler {
+    bool ikili = false;       // --format binary
+    bool tokenlar = false;    // --tokens
+    bool agac = false;        // --ast
+    bool istatistik = false;  // --stats: token/ağaç yerine dosya başına süre ve sayılar
+    unsigned isParcacigi = 0; // -j (0: çekirdek sayısı)
+    std::string onbellek;     // --cache (boş: önbellek kapalı)
+    const char *cikti = nullptr;
+    std::vector<const char *> yollar;
+    std::vector<std::string_view> aranan;  // --find ile aranan adlar
+
+    // Dosya kaydı (token'lar veya ağaç) yazılacak mı
+    bool kayit() const { return tokenlar || agac; }
+    // Dosyalar ayrıştırılacak mı; --find ağaçtaki tanım ve kullanım kayıtlarını okur
+    bool ayristir() const { return agac || !aranan.empty(); }
+};
+
+// Bütün iş parçacıklarının paylaştığı çapraz başvuru dizini (--find)
+// Dosyalar kilitsiz ayrıştırılır; kilit yalnızca ağacın kayıtları dizine
+// katılırken tutulur. Dosya numarası, dosya listesindeki sırasıdır.
+struct OrtakDizin {
+    std::mutex kilit;
+    SymbolIndex dizin;
+
+    template <typename Agac>
+    void kat(uint32_t dosya, const Agac &agac) {
+        std::lock_guard<std::mutex> lock(kilit);
+        dizin.update(dosya, agac);
+    }
+};
+
+// İşlenecek bir dosya
+struct Dosya {
+    std::string yol;
+    uintmax_t boyut;
+};
+
+// Her iş parçacığının dosyadan dosyaya yeniden kullandığı durum
+// Token ve ağaç tamponları en büyük dosyaya göre bir kez büyür; sonraki
+// dosyalar için bellek ayrılmaz ve iş parçacıkları ortak bir ayırıcı için
+// yarışmaz. Dosyalar kopyalanmaz, belleğe eşlenir.
+struct IsciDurumu {
+    EslenmisDosya dosya;
+    std::vector<Token> tokenlar;
+    Parser parser;
+    ParseTree agac;
+    OnbellekGirdisi girdi;
+    Yazici yazici;
+    OrtakDizin *dizin;  // --find verilmediyse nullptr
+    uint64_t bayt = 0;
+    uint64_t tokenSayisi = 0;
+    uint64_t dugumSayisi = 0;
+    uint64_t dosyaSayisi = 0;
+    uint64_t onbellekIsabeti = 0;
+
+    IsciDurumu(FILE *cikti, std::mutex *kilit, OrtakDizin *ortakDizin)
+        : yazici(cikti, kilit), dizin(ortakDizin) {}
+};
+
+// Kaynak dosya uzantıları; dizinler taranırken yalnızca bunlar alınır
+bool kaynakDosyasiMi(const std::filesystem::path &yol) {
+    static const char *uzantilar[] = {".c", ".h", ".cc", ".cpp", ".cxx", ".hh", ".hpp", ".hxx"};
+    std::string uzanti = yol.extension().string();
+    for (const char *u : uzantilar) {
+        if (uzanti == u) return true;
+    }
+    return false;
+}
+
+// Yolları dosya listesine açar; dizinler özyinelemeli olarak taranır
+// Liste büyükten küçüğe sıralanır ki büyük bir dosya en sona kalmasın
+void dosyalariTopla(const std::vector<const char *> &yollar, std::vector<Dosya> &dosyalar) {
+    namespace fs = std::filesystem;
+    for (const char *yol : yollar) {
+        std::error_code hata;
+        if (fs::is_directory(yol, hata)) {
+            fs::recursive_directory_iterator it(yol, fs::directory_options::skip_permission_denied, hata), son;
+            for (; !hata && it != son; it.increment(hata)) {
+                if (!it->is_regular_file(hata) || !kaynakDosyasiMi(it->path())) continue;
+                uintmax_t boyut = it->file_size(hata);
+                dosyalar.push_back(Dosya{it->path().string(), hata ? 0 : boyut});
+            }
+            if (hata) std::fprintf(stderr, "syntax_cli: %s: %s\n", yol, hata.message().c_str());
+        } else {
+            uintmax_t boyut = fs::file_size(yol, hata);
+            dosyalar.push_back(Dosya{yol, hata ? 0 : boyut});
+        }
+    }
+    std::stable_sort(dosyalar.begin(), dosyalar.end(),
+                     [](const Dosya &a, const Dosya &b) { return a.boyut > b.boyut; });
+}
+
+// Ağaç yazıcıları hem ParseTree'yi hem de önbellekteki ParseTreeView'ı okur
+// Ağacın derinliği sınırsız olduğundan (ör. 100 bin terimli bir toplama)
+// yazıcılar özyinelemez; ağacı açık bir yığınla dolaşır.
+struct DugumCercevesi {
+    NodeId dugum;
+    uint32_t sonraki;  // Yazılacak sonraki alt düğümün sırası
+};
+
+// Düğümün alt düğümlerinden önceki kısmı
+template <typename Agac>
+void jsonDugumBasi(Yazici &y, const Agac &agac, NodeId id) {
+    y.yaz("{\"type\":\"");
+    y.yaz(dugumTipiAdi(agac.type(id)));
+    y.yaz("\",\"value\":");
+    y.jsonMetni(agac.value(id));
+    y.yaz(",\"span\":[");
+    y.sayi(agac.spanStart(id));
+    y.yaz(',');
+    y.sayi(agac.spanEnd(id));
+    y.yaz("],\"children\":[");
+}
+
+template <typename Agac>
+void jsonDugum(Yazici &y, const Agac &agac, NodeId kok) {
+    std::vector<DugumCercevesi> yigin;
+    jsonDugumBasi(y, agac, kok);
+    yigin.push_back(DugumCercevesi{kok, 0});
+    while (!yigin.empty()) {
+        DugumCercevesi &c = yigin.back();
+        if (c.sonraki == agac.childCount(c.dugum)) {
+            y.yaz("]}");
+            yigin.pop_back();
+            continue;
+        }
+        if (c.sonraki) y.yaz(',');
+        NodeId alt = agac.child(c.dugum, c.sonraki++);
+        jsonDugumBasi(y, agac, alt);
+        yigin.push_back(DugumCercevesi{alt, 0});
+    }
+}
+
+// Kayıtlar üç adımda yazılır: baş, token grupları ve son. Token'lar akış
+// halinde geldiğinde her grup geldiği anda yazılır.
+void jsonBasla(Yazici &y, const Secenekler &s, const std::string &yol) {
+    y.yaz("{\"file\":");
+    y.jsonMetni(yol);
+    if (s.tokenlar) y.yaz(",\"tokens\":[");
+}
+
+void jsonTokenler(Yazici &y, uint64_t taban, const Token *tokenlar, size_t n, bool &ilk) {
+    for (size_t i = 0; i < n; ++i) {
+        const Token &t = tokenlar[i];
+        if (!ilk) y.yaz(',');
+        ilk = false;
+        y.yaz('[');
+        y.sayi(taban + t.baslangic);
+        y.yaz(',');
+        y.sayi(taban + t.bitis);
+        y.yaz(",\"");
+        y.yaz(tokenTipiAdi(t.tip));
+        y.yaz("\"]");
+    }
+}
+
+template <typename Agac>
+void jsonBitir(Yazici &y, const Secenekler &s, const Agac &agac) {
+    if (s.tokenlar) y.yaz(']');
+    if (s.agac) {
+        y.yaz(",\"ast\":");
+        jsonDugum(y, agac, agac.root());
+    }
+    y.yaz("}\n");
+}
+
+// Düğümün alt ağacındaki düğüm sayısı
+// Önbellekteki ağacın havuzunda çöp olabileceğinden havuzun boyutu kullanılmaz
+// Sıra önemli olmadığından yığında yalnızca henüz sayılmamış düğümler durur
+template <typename Agac>
+uint32_t altAgacBoyutu(const Agac &agac, NodeId kok) {
+    uint32_t n = 0;
+    std::vector<NodeId> yigin(1, kok);
+    while (!yigin.empty()) {
+        NodeId id = yigin.back();
+        yigin.pop_back();
+        ++n;
+        for (uint32_t i = 0; i < agac.childCount(id); ++i) yigin.push_back(agac.child(id, i));
+    }
+    return n;
+}
+
+template <typename Agac>
+void ikiliDugumBasi(Yazici &y, const Agac &agac, NodeId id) {
+    std::string_view deger = agac.value(id);
+    y.u8((uint8_t)agac.type(id));
+    y.u32(deger.empty() ? 0 : (uint32_t)(deger.data() - agac.source.data()));
+    y.u32((uint32_t)deger.size());
+    y.u32(agac.childCount(id));
+}
+
+// Düğümler önce-kök sırasıyla, her biri alt düğümlerinden önce yazılır
+template <typename Agac>
+void ikiliDugum(Yazici &y, const Agac &agac, NodeId kok) {
+    std::vector<DugumCercevesi> yigin;
+    ikiliDugumBasi(y, agac, kok);
+    yigin.push_back(DugumCercevesi{kok, 0});
+    while (!yigin.empty()) {
+        DugumCercevesi &c = yigin.back();
+        if (c.sonraki == agac.childCount(c.dugum)) {
+            yigin.pop_back();
+            continue;
+        }
+        NodeId alt = agac.child(c.dugum, c.sonraki++);
+        ikiliDugumBasi(y, agac, alt);
+        yigin.push_back(DugumCercevesi{alt, 0});
+    }
+}
+
+void ikiliBasla(Yazici &y, const std::string &yol) {
+    y.u32((uint32_t)yol.size());
+    y.yaz(yol);
+}
+
+void ikiliTokenler(Yazici &y, uint64_t taban, const Token *tokenlar, size_t n) {
+    if (n == 0) return;
+    y.u32((uint32_t)n);
+    for (size_t i = 0; i < n; ++i) {
+        const Token &t = tokenlar[i];
+        y.u64(taban + t.baslangic);
+        y.u64(taban + t.bitis);
+        y.u8((uint8_t)t.tip);
+    }
+}
+
+template <typename Agac>
+void ikiliBitir(Yazici &y, const Secenekler &s, const Agac &agac) {
+    y.u32(0);  // Token gruplarının sonu
+    if (s.agac) {
+        y.u32(altAgacBoyutu(agac, agac.root()));
+        ikiliDugum(y, agac, agac.root());
+    } else {
+        y.u32(0);
+    }
+}
+
+// onbellek: 0 önbellek kapalı, 1 isabet, -1 ıska
+void istatistikYaz(Yazici &y, const std::string &yol, size_t bayt, size_t tokenSayisi, size_t dugumSayisi,
+                   double lexSuresi, double parseSuresi, int onbellek = 0) {
+    y.yaz("{\"file\":");
+    y.jsonMetni(yol);
+    y.yaz(",\"bytes\":");
+    y.sayi(bayt);
+    y.yaz(",\"tokens\":");
+    y.sayi(tokenSayisi);
+    y.yaz(",\"nodes\":");
+    y.sayi(dugumSayisi);
+    y.yaz(",\"lex_us\":");
+    y.sayi((uint64_t)(lexSuresi * 1e6));
+    y.yaz(",\"parse_us\":");
+    y.sayi((uint64_t)(parseSuresi * 1e6));
+    if (onbellek) y.yaz(onbellek > 0 ? ",\"cache\":\"hit\"" : ",\"cache\":\"miss\"");
+    y.yaz("}\n");
+}
+
+double gecenSure(std::chrono::steady_clock::time_point bas, std::chrono::steady_clock::time_point son) {
+    return std::chrono::duration<double>(son - bas).count();
+}
+
+// Ağaç istenmediğinde dosya belleğe alınmadan akış halinde lexlenir;
+// bellek kullanımı dosyanın boyutundan bağımsızdır
+bool dosyayiAkisIleIsle(const Secenekler &s, const Dosya &dosya, IsciDurumu &d) {
+    Yazici &y = d.yazici;
+    uint64_t tokenSayisi = 0;
+    bool basladi = false;
+    bool ilk = true;
+    auto basla = [&] {
+        basladi = true;
+        if (s.istatistik) return;
+        if (s.ikili) ikiliBasla(y, dosya.yol);
+        else jsonBasla(y, s, dosya.yol);
+    };
+    auto t0 = std::chrono::steady_clock::now();
+    bool tamam = dosyayiAkisIleLexle(dosya.yol.c_str(), [&](uint64_t taban, const std::vector<Token> &tokenlar) {
+        if (!basladi) basla();
+        tokenSayisi += tokenlar.size();
+        if (s.istatistik || !s.tokenlar) return;
+        if (s.ikili) ikiliTokenler(y, taban, tokenlar.data(), tokenlar.size());
+        else jsonTokenler(y, taban, tokenlar.data(), tokenlar.size(), ilk);
+        y.araBosalt();
+    });
+    auto t1 = std::chrono::steady_clock::now();
+    if (!tamam) {
+        std::fprintf(stderr, "syntax_cli: %s okunamadi\n", dosya.yol.c_str());
+    }
+    if (!tamam && !basladi) return false;
+    if (!basladi) basla();
+
+    d.bayt += dosya.boyut;
+    d.tokenSayisi += tokenSayisi;
+    d.dosyaSayisi++;
+    // Yarıda kalan kayıt da kapatılır ki çıktı bozulmasın
+    if (s.istatistik) {
+        istatistikYaz(y, dosya.yol, dosya.boyut, tokenSayisi, 0, gecenSure(t0, t1), 0);
+    } else if (s.ikili) {
+        ikiliBitir(y, s, d.agac);
+    } else {
+        jsonBitir(y, s, d.agac);
+    }
+    y.kayitBitti();
+    return tamam;
+}
+
+// Kaydı token'lardan ve ağaçtan yazar; ağaç ParseTree veya ParseTreeView olabilir
+template <typename Agac>
+void kayitYaz(const Secenekler &s, const std::string &yol, IsciDurumu &d, const Token *tokenlar,
+              size_t tokenSayisi, const Agac &agac) {
+    Yazici &y = d.yazici;
+    if (s.ikili) {
+        ikiliBasla(y, yol);
+        if (s.tokenlar) ikiliTokenler(y, 0, tokenlar, tokenSayisi);
+        ikiliBitir(y, s, agac);
+    } else {
+        bool ilk = true;
+        jsonBasla(y, s, yol);
+        if (s.tokenlar) jsonTokenler(y, 0, tokenlar, tokenSayisi, ilk);
+        jsonBitir(y, s, agac);
+    }
+}
+
+// Önbellekte metnin istenen çıktı için yeterli bir girdisi varsa kaydı ondan yazar
+// Token'lar ve ağaç eşlenen dosyadan kopyalanmadan okunur
+bool onbellektenIsle(const Secenekler &s, const std::string &yol, uint32_t no, IsciDurumu &d,
+                     std::string_view metin, uint64_t ozet) {
+    OnbellekGirdisi &g = d.girdi;
+    if (!g.ac(s.onbellek, ozet, metin.size())) return false;
+    if (s.ayristir() && !g.agacVar()) {
+        g.kapat();
+        return false;
+    }
+    ParseTreeView agac;
+    if (g.agacVar()) agac = ParseTreeView(g.agac(), metin);
+    if (d.dizin) d.dizin->kat(no, agac);
+    size_t dugumSayisi = g.agacVar() ? agac.nodeCount() : 0;
+    d.bayt += metin.size();
+    d.tokenSayisi += g.tokenSayisi();
+    d.dugumSayisi += s.ayristir() ? dugumSayisi : 0;
+    d.dosyaSayisi++;
+    d.onbellekIsabeti++;
+    if (s.istatistik) {
+        istatistikYaz(d.yazici, yol, metin.size(), g.tokenSayisi(), s.ayristir() ? dugumSayisi : 0, 0, 0, 1);
+    } else if (s.kayit()) {
+        kayitYaz(s, yol, d, g.tokenlar(), g.tokenSayisi(), agac);
+    }
+    d.yazici.kayitBitti();
+    g.kapat();
+    return true;
+}
+
+// Tek bir dosyayı iş parçacığının kendi durumuyla işler
+bool dosyaIsle(const Secenekler &s, const Dosya &dosya, uint32_t no, IsciDurumu &d) {
+    // Önbellek için metnin tamamının özeti gerekir; önbellek kapalıysa ağaç
+    // istenmediğinde dosya akış halinde işlenir
+    if (!s.ayristir() && s.onbellek.empty()) return dosyayiAkisIleIsle(s, dosya, d);
+    if (!d.dosya.ac(dosya.yol.c_str())) {
+        std::fprintf(stderr, "syntax_cli: %s okunamadi\n", dosya.yol.c_str());
+        return false;
+    }
+    std::string_view metin = d.dosya.metin();
+    if (metin.size() > (size_t)INT32_MAX) {
+        d.dosya.kapat();
+        if (!s.ayristir()) return dosyayiAkisIleIsle(s, dosya, d);
+        std::fprintf(stderr, "syntax_cli: %s sozdizimi agaci icin cok buyuk; --tokens ile akis halinde islenebilir\n",
+                     dosya.yol.c_str());
+        return false;
+    }
+    uint64_t ozet = 0;
+    if (!s.onbellek.empty()) {
+        ozet = icerikOzeti(metin.data(), metin.size());
+        if (onbellektenIsle(s, dosya.yol, no, d, metin, ozet)) {
+            d.dosya.kapat();
+            return true;
+        }
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    d.tokenlar.clear();
+    tokenizeMetin(metin.data(), metin.size(), d.tokenlar);
+    auto t1 = std::chrono::steady_clock::now();
+    if (s.ayristir()) d.parser.parse(metin, d.tokenlar, d.agac);
+    auto t2 = std::chrono::steady_clock::now();
+    if (d.dizin) d.dizin->kat(no, d.agac);
+
+    size_t dugumSayisi = s.ayristir() ? d.agac.nodeCount() : 0;
+    d.bayt += metin.size();
+    d.tokenSayisi += d.tokenlar.size();
+    d.dugumSayisi += dugumSayisi;
+    d.dosyaSayisi++;
+    if (s.istatistik) {
+        istatistikYaz(d.yazici, dosya.yol, metin.size(), d.tokenlar.size(), dugumSayisi,
+                      gecenSure(t0, t1), gecenSure(t1, t2), s.onbellek.empty() ? 0 : -1);
+    } else if (s.kayit()) {
+        kayitYaz(s, dosya.yol, d, d.tokenlar.data(), d.tokenlar.size(), d.agac);
+    }
+    d.yazici.kayitBitti();
+    if (!s.onbellek.empty()) {
+        OnbellekIcerigi icerik;
+        icerik.ozet = ozet;
+        icerik.metinUzunlugu = metin.size();
+        icerik.tokenlar = d.tokenlar.data();
+        icerik.tokenSayisi = d.tokenlar.size();
+        ParseTreeImage agac = d.agac.image();
+        if (s.ayristir()) icerik.agac = &agac;
+        if (!onbellegeYaz(s.onbellek, icerik)) {
+            std::fprintf(stderr, "syntax_cli: %s onbellege yazilamadi\n", dosya.yol.c_str());
+        }
+    }
+    d.dosya.kapat();
+    return true;
+}
+
+const char *sembolRoluAdi(SymbolRole rol) {
+    switch (rol) {
+        case SYMBOL_VARIABLE: return "variable";
+        case SYMBOL_PARAMETER: return "parameter";
+        case SYMBOL_FUNCTION: return "function";
+        default: return "use";
+    }
+}
+
+// Adın tanımlarını ve kullanımlarını dosya ve konum sırasıyla bir JSON satırı olarak yazar
+// {"symbol":ad,"definitions":[[dosya,bas,son,rol],...],"uses":[[dosya,bas,son],...]}
+void aramaYaz(Yazici &y, const SymbolIndex &dizin, const std::vector<Dosya> &dosyalar, std::string_view ad,
+              std::vector<SymbolLocation> &yerler) {
+    auto sirala = [&yerler] {
+        std::sort(yerler.begin(), yerler.end(), [](const SymbolLocation &a, const SymbolLocation &b) {
+            return a.file != b.file ? a.file < b.file : a.start < b.start;
+        });
+    };
+    auto yerleriYaz = [&](bool rolYaz) {
+        for (size_t i = 0; i < yerler.size(); ++i) {
+            const SymbolLocation &yer = yerler[i];
+            if (i) y.yaz(',');
+            y.yaz('[');
+            y.jsonMetni(dosyalar[yer.file].yol);
+            y.yaz(',');
+            y.sayi(yer.start);
+            y.yaz(',');
+            y.sayi(yer.start + yer.length);
+            if (rolYaz) {
+                y.yaz(",\"");
+                y.yaz(sembolRoluAdi(yer.role));
+                y.yaz('"');
+            }
+            y.yaz(']');
+        }
+    };
+    y.yaz("{\"symbol\":");
+    y.jsonMetni(ad);
+    y.yaz(",\"definitions\":[");
+    yerler.clear();
+    dizin.definitions(ad, yerler);
+    sirala();
+    yerleriYaz(true);
+    y.yaz("],\"uses\":[");
+    yerler.clear();
+    dizin.uses(ad, yerler);
+    sirala();
+    yerleriYaz(false);
+    y.yaz("]}\n");
+    y.kayitBitti();
+}
+
+void kullanim() {
+    std::fprintf(stderr, "Kullanim: syntax_cli [--format json|binary] [--tokens] [--ast] [--stats] [--cache dizin] [--find ad]... [-j N] [-o cikti] yol...\n");
+}
+
+bool seceneklerOku(int argc, char **argv, Secenekler &s) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view a = argv[i];
+        if (a == "--format" && i + 1 < argc) {
+            std::string_view f = argv[++i];
+            if (f == "json") s.ikili = false;
+            else if (f == "binary") s.ikili = true;
+            else return false;
+        } else if (a == "--tokens") {
+            s.tokenlar = true;
+        } else if (a == "--ast") {
+            s.agac = true;
+        } else if (a == "--stats") {
+            s.istatistik = true;
+        } else if (a == "--cache" && i + 1 < argc) {
+            s.onbellek = argv[++i];
+        } else if (a == "--find" && i + 1 < argc) {
+            s.aranan.push_back(argv[++i]);
+        } else if (a == "-j" && i + 1 < argc) {
+            s.isParcacigi = (unsigned)std::atoi(argv[++i]);
+        } else if (a == "-o" && i + 1 < argc) {
+            s.cikti = argv[++i];
+        } else if (a.size() > 1 && a[0] == '-') {
+            return false;
+        } else {
+            s.yollar.push_back(argv[i]);
+        }
+    }
+    if (!s.tokenlar && !s.agac && s.aranan.empty()) s.tokenlar = s.agac = true;
+    // Arama sonuçları JSON satırlarıdır; ikili akışa karışmaz
+    if (s.ikili && !s.aranan.empty() && !s.istatistik) return false;
+    return !s.yollar.empty();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Secenekler s;
+    if (!seceneklerOku(argc, argv, s)) {
+        kullanim();
+        return 2;
+    }
+    FILE *cikti = s.cikti ? std::fopen(s.cikti, "wb") : stdout;
+    if (!cikti) {
+        std::fprintf(stderr, "syntax_cli: %s acilamadi\n", s.cikti);
+        return 1;
+    }
+    if (s.istatistik) s.ikili = false;
+    if (s.ikili) std::fwrite("SHX2", 1, 4, cikti);
+
+    std::vector<Dosya> dosyalar;
+    dosyalariTopla(s.yollar, dosyalar);
+
+    WorkStealingPool havuz(s.isParcacigi);
+    std::mutex ciktiKilidi;
+    std::unique_ptr<OrtakDizin> dizin;
+    if (!s.aranan.empty()) dizin.reset(new OrtakDizin());
+    std::vector<std::unique_ptr<IsciDurumu>> durumlar;
+    for (unsigned i = 0; i < havuz.size(); ++i) {
+        durumlar.emplace_back(new IsciDurumu(cikti, &ciktiKilidi, dizin.get()));
+    }
+
+    std::atomic<bool> hataVar(false);
+    auto bas = std::chrono::steady_clock::now();
+    havuz.run(dosyalar.size(), [&](size_t i, unsigned isci) {
+        if (!dosyaIsle(s, dosyalar[i], (uint32_t)i, *durumlar[isci])) hataVar = true;
+    });
+    double sure = gecenSure(bas, std::chrono::steady_clock::now());
+
+    uint64_t bayt = 0, tokenSayisi = 0, dugumSayisi = 0, dosyaSayisi = 0, onbellekIsabeti = 0;
+    for (auto &d : durumlar) {
+        d->yazici.bosalt();
+        bayt += d->bayt;
+        tokenSayisi += d->tokenSayisi;
+        dugumSayisi += d->dugumSayisi;
+        dosyaSayisi += d->dosyaSayisi;
+        onbellekIsabeti += d->onbellekIsabeti;
+    }
+    if (dizin) {
+        // Aramalar dizinin kurulma süresine katılmaz; her biri bir karma araması ve sonuç sayısı kadar iştir
+        Yazici y(cikti, &ciktiKilidi);
+        std::vector<SymbolLocation> yerler;
+        for (std::string_view ad : s.aranan) aramaYaz(y, dizin->dizin, dosyalar, ad, yerler);
+    }
+    if (s.istatistik) {
+        Yazici y(cikti, &ciktiKilidi);
+        y.yaz("{\"summary\":{\"files\":");
+        y.sayi(dosyaSayisi);
+        y.yaz(",\"failed\":");
+        y.sayi(dosyalar.size() - dosyaSayisi);
+        y.yaz(",\"bytes\":");
+        y.sayi(bayt);
+        y.yaz(",\"tokens\":");
+        y.sayi(tokenSayisi);
+        y.yaz(",\"nodes\":");
+        y.sayi(dugumSayisi);
+        y.yaz(",\"threads\":");
+        y.sayi(havuz.size());
+        if (!s.onbellek.empty()) {
+            y.yaz(",\"cache_hits\":");
+            y.sayi(onbellekIsabeti);
+        }
+        if (dizin) {
+            y.yaz(",\"symbols\":");
+            y.sayi(dizin->dizin.symbols().size());
+            y.yaz(",\"references\":");
+            y.sayi(dizin->dizin.entryCount());
+        }
+        y.yaz(",\"wall_us\":");
+        y.sayi((uint64_t)(sure * 1e6));
+        y.yaz("}}\n");
+    }
+    durumlar.clear();
+    if (cikti != stdout) std::fclose(cikti);
+    return hataVar ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+#include "dosya_girdisi.h"
+#include <algorithm>
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DOSYA_ESLEME 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Lexer'a bir seferde beslenen blok; biriken token listesi bununla sınırlıdır
+const size_t BESLEME_BLOGU = 1u << 20;
+
+bool tamaminiOku(const char *yol, std::string &icerik) {
+    FILE *f = std::fopen(yol, "rb");
+    if (!f) return false;
+    icerik.clear();
+    char blok[65536];
+    size_t n;
+    while ((n = std::fread(blok, 1, sizeof(blok), f)) > 0) icerik.append(blok, n);
+    bool hata = std::ferror(f) != 0;
+    std::fclose(f);
+    return !hata;
+}
+
+// Bir bloğu lexer'a besler ve biriken token'ları teslim eder
+void blokBesle(Lexer &lexer, std::vector<Token> &tokenlar, const char *p, size_t n,
+               const TokenTeslimi &teslim) {
+    uint64_t taban = lexer.tabaniIlerlet();
+    lexer.besle(p, n);
+    if (!tokenlar.empty()) {
+        teslim(taban, tokenlar);
+        tokenlar.clear();
+    }
+}
+
+// Eşlenemeyen dosyaları blok blok okuyarak lexler
+bool okuyarakLexle(const char *yol, const TokenTeslimi &teslim) {
+    FILE *f = std::fopen(yol, "rb");
+    if (!f) return false;
+    std::vector<Token> tokenlar;
+    Lexer lexer(tokenlar);
+    std::vector<char> blok(BESLEME_BLOGU);
+    size_t n;
+    while ((n = std::fread(blok.data(), 1, blok.size(), f)) > 0) {
+        blokBesle(lexer, tokenlar, blok.data(), n, teslim);
+    }
+    bool hata = std::ferror(f) != 0;
+    std::fclose(f);
+    uint64_t taban = lexer.tabaniIlerlet();
+    lexer.bitir();
+    if (!tokenlar.empty()) teslim(taban, tokenlar);
+    return !hata;
+}
+
+} // namespace
+
+bool EslenmisDosya::ac(const char *yol) {
+    kapat();
+#ifdef DOSYA_ESLEME
+    int fd = ::open(yol, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat bilgi;
+    if (::fstat(fd, &bilgi) == 0 && S_ISREG(bilgi.st_mode) && bilgi.st_size > 0) {
+        void *p = ::mmap(nullptr, (size_t)bilgi.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            ::close(fd);
+            adres = static_cast<const char *>(p);
+            uzunluk = (size_t)bilgi.st_size;
+            eslendi = true;
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+    if (!tamaminiOku(yol, yedek)) return false;
+    adres = yedek.data();
+    uzunluk = yedek.size();
+    return true;
+}
+
+void EslenmisDosya::kapat() {
+#ifdef DOSYA_ESLEME
+    if (eslendi) ::munmap(const_cast<char *>(adres), uzunluk);
+#endif
+    adres = nullptr;
+    uzunluk = 0;
+    eslendi = false;
+    yedek.clear();
+}
+
+bool dosyayiAkisIleLexle(const char *yol, const TokenTeslimi &teslim, size_t pencere) {
+#ifdef DOSYA_ESLEME
+    int fd = ::open(yol, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat bilgi;
+    if (::fstat(fd, &bilgi) != 0 || !S_ISREG(bilgi.st_mode)) {
+        ::close(fd);
+        return okuyarakLexle(yol, teslim);
+    }
+    // Pencereler sayfa sınırlarından başlamalıdır
+    const size_t sayfa = (size_t)::sysconf(_SC_PAGESIZE);
+    pencere = std::max(sayfa, pencere / sayfa * sayfa);
+    const uint64_t boyut = (uint64_t)bilgi.st_size;
+
+    std::vector<Token> tokenlar;
+    Lexer lexer(tokenlar);
+    for (uint64_t ofset = 0; ofset < boyut; ofset += pencere) {
+        size_t n = (size_t)std::min<uint64_t>(pencere, boyut - ofset);
+        void *p = ::mmap(nullptr, n, PROT_READ, MAP_PRIVATE, fd, (off_t)ofset);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        ::madvise(p, n, MADV_SEQUENTIAL);
+        const char *parca = static_cast<const char *>(p);
+        for (size_t i = 0; i < n; i += BESLEME_BLOGU) {
+            blokBesle(lexer, tokenlar, parca + i, std::min(BESLEME_BLOGU, n - i), teslim);
+        }
+        ::munmap(p, n);
+    }
+    ::close(fd);
+    uint64_t taban = lexer.tabaniIlerlet();
+    lexer.bitir();
+    if (!tokenlar.empty()) teslim(taban, tokenlar);
+    return true;
+#else
+    (void)pencere;
+    return okuyarakLexle(yol, teslim);
+#endif
+}
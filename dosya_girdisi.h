@@ -0,0 +1,46 @@
+#ifndef DOSYA_GIRDISI_H
+#define DOSYA_GIRDISI_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "lexer.h"
+
+// Salt okunur olarak belleğe eşlenmiş dosya
+// Metin kopyalanmaz; sayfalar okundukça işletim sistemi tarafından yüklenir.
+// mmap desteklenmeyen sistemlerde veya eşlenemeyen dosyalarda (boru, boş
+// dosya gibi) dosya belleğe okunur.
+class EslenmisDosya {
+public:
+    EslenmisDosya() : adres(nullptr), uzunluk(0), eslendi(false) {}
+    ~EslenmisDosya() { kapat(); }
+    EslenmisDosya(const EslenmisDosya &) = delete;
+    EslenmisDosya &operator=(const EslenmisDosya &) = delete;
+
+    // Dosyayı açar; önceki dosya kapatılır
+    bool ac(const char *yol);
+    void kapat();
+    std::string_view metin() const { return std::string_view(adres, uzunluk); }
+
+private:
+    const char *adres;  // Eşlenen bölge veya yedek'in verisi
+    size_t uzunluk;
+    bool eslendi;       // adres munmap ile bırakılmalı mı
+    std::string yedek;  // Eşlenemeyen dosyanın içeriği
+};
+
+// Token'ları ve konumlarının göreli olduğu metin konumunu alan fonksiyon
+// Token'ın gerçek konumu taban + baslangic'tir.
+typedef std::function<void(uint64_t taban, const std::vector<Token> &tokenlar)> TokenTeslimi;
+
+// Dosyayı sabit ek bellekle token'lara ayırır
+// Dosya 'pencere' baytlık parçalar halinde eşlenip bırakılır. Her parça
+// daha küçük bloklar halinde lexer'a beslenir ve biriken token'lar her
+// bloktan sonra 'teslim' ile verilir. Bellek kullanımı dosyanın boyutuna
+// bağlı değildir; çok gigabaytlık dosyalar da işlenebilir.
+bool dosyayiAkisIleLexle(const char *yol, const TokenTeslimi &teslim, size_t pencere = 64u << 20);
+
+#endif
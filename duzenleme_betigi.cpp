@@ -0,0 +1,95 @@
+#include "duzenleme_betigi.h"
+#include <cstdlib>
+#include <cstring>
+
+const char *duzenlemeTuru(const char *silinenMetin, int silinen, const std::string &eklenen) {
+    if (eklenen == "/*" && silinen == 0) return "yorum_acma";
+    if (eklenen.empty() && silinen == 2 && silinenMetin && std::strncmp(silinenMetin, "/*", 2) == 0) {
+        return "yorum_kapatma";
+    }
+    if (silinen == 0 && eklenen.size() == 1) return "yazma";
+    if (silinen == 1 && eklenen.empty()) return "geri_silme";
+    if (silinen == 0) return "yapistirma";
+    if (eklenen.empty() && silinenMetin && silinenMetin[silinen - 1] == '\n') return "satir_silme";
+    if (eklenen.empty()) return "silme";
+    return "degistirme";
+}
+
+void duzenlemeYaz(FILE *f, const Duzenleme &duzenleme) {
+    std::fprintf(f, "%s\t%d\t%d\t", duzenleme.tur.c_str(), duzenleme.konum, duzenleme.silinen);
+    for (char c : duzenleme.eklenen) {
+        switch (c) {
+            case '\\': std::fputs("\\\\", f); break;
+            case '\n': std::fputs("\\n", f); break;
+            case '\r': std::fputs("\\r", f); break;
+            case '\t': std::fputs("\\t", f); break;
+            default: std::fputc(c, f); break;
+        }
+    }
+    std::fputc('\n', f);
+}
+
+namespace {
+
+// "tür<TAB>konum<TAB>silinen<TAB>eklenen" satırını çözer
+bool satirCoz(const std::string &satir, Duzenleme &duzenleme) {
+    size_t a = satir.find('\t');
+    if (a == std::string::npos || a == 0) return false;
+    size_t b = satir.find('\t', a + 1);
+    if (b == std::string::npos) return false;
+    size_t c = satir.find('\t', b + 1);
+    if (c == std::string::npos) return false;
+    duzenleme.tur.assign(satir, 0, a);
+    char *son;
+    long konum = std::strtol(satir.c_str() + a + 1, &son, 10);
+    if (son != satir.c_str() + b || konum < 0) return false;
+    long silinen = std::strtol(satir.c_str() + b + 1, &son, 10);
+    if (son != satir.c_str() + c || silinen < 0) return false;
+    duzenleme.konum = (int)konum;
+    duzenleme.silinen = (int)silinen;
+    duzenleme.eklenen.clear();
+    for (size_t i = c + 1; i < satir.size(); ++i) {
+        char ch = satir[i];
+        if (ch == '\\' && i + 1 < satir.size()) {
+            switch (satir[++i]) {
+                case 'n': ch = '\n'; break;
+                case 'r': ch = '\r'; break;
+                case 't': ch = '\t'; break;
+                case '\\': ch = '\\'; break;
+                default: return false;
+            }
+        }
+        duzenleme.eklenen += ch;
+    }
+    return true;
+}
+
+} // namespace
+
+bool betikOku(const char *yol, std::vector<Duzenleme> &betik, int *hataliSatir) {
+    FILE *f = std::fopen(yol, "rb");
+    if (!f) return false;
+    betik.clear();
+    std::string satir;
+    int satirNo = 0;
+    bool tamam = true;
+    char blok[4096];
+    while (tamam && std::fgets(blok, sizeof(blok), f)) {
+        satir += blok;
+        if (satir.back() != '\n' && !std::feof(f)) continue;  // Satır bloktan uzun
+        if (!satir.empty() && satir.back() == '\n') satir.pop_back();
+        ++satirNo;
+        if (!satir.empty() && satir[0] != '#') {
+            Duzenleme duzenleme;
+            if (satirCoz(satir, duzenleme)) {
+                betik.push_back(std::move(duzenleme));
+            } else {
+                tamam = false;
+                if (hataliSatir) *hataliSatir = satirNo;
+            }
+        }
+        satir.clear();
+    }
+    std::fclose(f);
+    return tamam;
+}
@@ -0,0 +1,30 @@
+#ifndef DUZENLEME_BETIGI_H
+#define DUZENLEME_BETIGI_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Yeniden oynatılabilir düzenleme betiği
+// Her satır bir düzenlemedir: "tür<TAB>konum<TAB>silinen<TAB>eklenen".
+// 'silinen', konumdan itibaren silinen bayt sayısıdır; 'eklenen' metni
+// \\, \n, \r ve \t kaçışlarıyla yazılır. '#' ile başlayan satırlar yok sayılır.
+// "yukle" türündeki düzenleme bütün metni değiştirir ve ölçülmez; kaydedilen
+// betikler başlangıç metnini bu şekilde taşır.
+struct Duzenleme {
+    std::string tur;      // yazma, geri_silme, yapistirma, satir_silme, yorum_acma, yorum_kapatma, ...
+    int konum;
+    int silinen;
+    std::string eklenen;
+};
+
+// Düzenlemeyi silinen ve eklenen metne bakarak sınıflandırır (kayıt sırasında)
+const char *duzenlemeTuru(const char *silinenMetin, int silinen, const std::string &eklenen);
+
+// Düzenlemeyi betiğe tek satır olarak yazar
+void duzenlemeYaz(FILE *f, const Duzenleme &duzenleme);
+// Betiği okur; dosya açılamazsa veya bir satır bozuksa false döndürür
+// (hatalı satırın numarası 'hataliSatir'a yazılır)
+bool betikOku(const char *yol, std::vector<Duzenleme> &betik, int *hataliSatir = nullptr);
+
+#endif
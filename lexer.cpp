@@ -0,0 +1,665 @@
+#include "lexer.h"
+#include "belge.h"
+#include "tarama.h"
+#include "anahtar_kelimeler.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+// Karakter sınıfları
+// Durum makinesi her karakteri önce bu sınıflardan birine indirger
+enum KarakterSinifi : uint8_t {
+    KS_DIGER = 0,       // Token başlatmayan karakterler (ASCII dışı baytlar, kontrol karakterleri)
+    KS_BOSLUK,          // Boşluk, tab, satır sonu
+    KS_HARF,            // a-z, A-Z, _
+    KS_RAKAM,           // 0-9
+    KS_OPERATOR,        // + - * % = & | < > !
+    KS_BOLU,            // / (yorum başlangıcı olabilir)
+    KS_CIFT_TIRNAK,     // "
+    KS_TEK_TIRNAK,      // '
+    KS_NOKTALAMA        // ( ) { } [ ] ; , . : ? ~ ^ #
+};
+
+struct SinifTablosu {
+    uint8_t sinif[256];
+    constexpr SinifTablosu() : sinif() {
+        for (int c = 'a'; c <= 'z'; ++c) sinif[c] = KS_HARF;
+        for (int c = 'A'; c <= 'Z'; ++c) sinif[c] = KS_HARF;
+        for (int c = '0'; c <= '9'; ++c) sinif[c] = KS_RAKAM;
+        sinif[(unsigned char)'_'] = KS_HARF;
+        sinif[(unsigned char)' '] = KS_BOSLUK;
+        sinif[(unsigned char)'\t'] = KS_BOSLUK;
+        sinif[(unsigned char)'\n'] = KS_BOSLUK;
+        sinif[(unsigned char)'\r'] = KS_BOSLUK;
+        sinif[(unsigned char)'\v'] = KS_BOSLUK;
+        sinif[(unsigned char)'\f'] = KS_BOSLUK;
+        const char operatorler[] = "+-*%=&|<>!";
+        for (int i = 0; operatorler[i]; ++i) sinif[(unsigned char)operatorler[i]] = KS_OPERATOR;
+        sinif[(unsigned char)'/'] = KS_BOLU;
+        sinif[(unsigned char)'"'] = KS_CIFT_TIRNAK;
+        sinif[(unsigned char)'\''] = KS_TEK_TIRNAK;
+        const char ayraclar[] = "(){}[];,.:?~^#\\@$`";
+        for (int i = 0; ayraclar[i]; ++i) sinif[(unsigned char)ayraclar[i]] = KS_NOKTALAMA;
+    }
+};
+
+constexpr SinifTablosu tablo;
+
+// Tarama çekirdekleri sınıfları tablo yerine bayt aralıklarıyla tanır;
+// tablo değişirse bu eşdeğerlik de korunmalıdır
+constexpr bool taramaylaUyumlu() {
+    for (int c = 0; c < 256; ++c) {
+        bool tokenBasi = c >= 0x21 && c <= 0x7E;
+        bool kelime = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        if ((tablo.sinif[c] > KS_BOSLUK) != tokenBasi) return false;
+        if ((tablo.sinif[c] == KS_HARF || tablo.sinif[c] == KS_RAKAM) != kelime) return false;
+    }
+    return true;
+}
+static_assert(taramaylaUyumlu(), "karakter sınıfları tarama çekirdekleriyle uyuşmuyor");
+
+inline uint8_t sinifi(char c) { return tablo.sinif[(unsigned char)c]; }
+
+// v[bas, son) aralığını yeni elemanlarla değiştirir, sonraki elemanları kaydırır
+template <typename T>
+void araligiDegistir(std::vector<T> &v, size_t bas, size_t son, const std::vector<T> &yeni) {
+    size_t eskiSayi = son - bas;
+    if (yeni.size() > eskiSayi) {
+        v.insert(v.begin() + son, yeni.size() - eskiSayi, T());
+    } else {
+        v.erase(v.begin() + bas + yeni.size(), v.begin() + son);
+    }
+    std::copy(yeni.begin(), yeni.end(), v.begin() + bas);
+}
+
+// v'nin kapasitesini boyutunun 'pay' fazlasına indirir
+template <typename T>
+void kapasiteyiKirp(std::vector<T> &v, size_t pay) {
+    if (v.capacity() <= v.size() + pay) return;
+    std::vector<T> yeni;
+    yeni.reserve(v.size() + pay);
+    yeni.assign(v.begin(), v.end());
+    v.swap(yeni);
+}
+
+// Kaynağın [baslangic, bitis) aralığını lexer'a satır satır besler
+// Her satır başında satirBasi(konum) çağrılır; true döndürürse lexleme orada
+// durur ve true döndürülür. Aralığın sonuna gelinirse false döndürülür.
+template <typename F>
+bool satirSatirLexle(const MetinKaynagi &kaynak, Lexer &lexer, int baslangic, int bitis, size_t blok, F satirBasi) {
+    std::string parca;
+    for (int okunan = baslangic; okunan < bitis;) {
+        int blokSonu = std::min<int>(bitis, okunan + (int)blok);
+        kaynak.oku(okunan, blokSonu, parca);
+        const char *p = parca.data();
+        size_t kalan = parca.size();
+        // Parçayı satır satır besle ki her satır başındaki durum kaydedilebilsin
+        while (kalan > 0) {
+            const char *satirSonu = static_cast<const char *>(std::memchr(p, '\n', kalan));
+            size_t n = satirSonu ? satirSonu - p + 1 : kalan;
+            lexer.besle(p, n);
+            p += n;
+            kalan -= n;
+            if (!satirSonu) break;
+            if (satirBasi((int)lexer.konum())) return true;
+        }
+        okunan = blokSonu;
+    }
+    return false;
+}
+
+} // namespace
+
+bool anahtarKelimeMi(const char *kelime, size_t uzunluk) {
+    return (kelimeTuru(kelime, uzunluk) & KT_ANAHTAR) != 0;
+}
+
+void Lexer::sifirla(size_t yeniOfset) {
+    mevcutDurum = LD_NORMAL;
+    ofset = yeniOfset;
+    tokenBaslangic = yeniOfset;
+    kelimeUzunlugu = 0;
+    taban = 0;
+}
+
+void Lexer::kelimeyiKapat(size_t bitis) {
+    bool anahtar = kelimeUzunlugu <= KELIME_SINIRI && anahtarKelimeMi(kelime, kelimeUzunlugu);
+    ekle(tokenBaslangic, bitis, anahtar ? ANAHTAR_KELIME : TANIMLAYICI);
+}
+
+void Lexer::besle(const char *p, size_t n) {
+    // Uzun karakter dizileri çalışma anında seçilen SIMD çekirdekleriyle taranır
+    const TaramaCekirdekleri cekirdek = tarama;
+    size_t i = 0;
+    while (i < n) {
+        switch (mevcutDurum) {
+        case LD_NORMAL: {
+            // Token başlatmayan karakterleri atla; tek boşluk çekirdeği çağırmaya değmez
+            if (sinifi(p[i]) <= KS_BOSLUK) {
+                ++i;
+                if (i < n && sinifi(p[i]) <= KS_BOSLUK) i = cekirdek.tokenBaslangici(p, i + 1, n);
+            }
+            if (i == n) break;
+            tokenBaslangic = ofset + i;
+            switch (sinifi(p[i])) {
+            case KS_HARF:
+                mevcutDurum = LD_TANIMLAYICI;
+                kelimeUzunlugu = 0;
+                break;  // Karakter tanımlayıcı durumunda okunacak
+            case KS_RAKAM:
+                mevcutDurum = LD_SAYI;
+                ++i;
+                break;
+            case KS_OPERATOR:
+                ekle(tokenBaslangic, tokenBaslangic + 1, OPERATOR);
+                ++i;
+                break;
+            case KS_BOLU:
+                mevcutDurum = LD_BOLU;
+                ++i;
+                break;
+            case KS_CIFT_TIRNAK:
+                mevcutDurum = LD_METIN;
+                ++i;
+                break;
+            case KS_TEK_TIRNAK:
+                mevcutDurum = LD_KARAKTER;
+                ++i;
+                break;
+            case KS_NOKTALAMA:
+                ekle(tokenBaslangic, tokenBaslangic + 1, NOKTALAMA);
+                ++i;
+                break;
+            }
+            break;
+        }
+        case LD_TANIMLAYICI: {
+            size_t son = cekirdek.kelimeSonu(p, i, n);
+            // Anahtar kelime kontrolü için yalnızca ilk KELIME_SINIRI karakter saklanır
+            if (kelimeUzunlugu < KELIME_SINIRI) {
+                std::memcpy(kelime + kelimeUzunlugu, p + i, std::min(son - i, KELIME_SINIRI - kelimeUzunlugu));
+            }
+            kelimeUzunlugu += son - i;
+            i = son;
+            if (i < n) {
+                kelimeyiKapat(ofset + i);
+                mevcutDurum = LD_NORMAL;
+            }
+            break;
+        }
+        case LD_SAYI:
+            // Rakamlar ve 10u, 0x1F gibi son ekler sayının parçasıdır
+            i = cekirdek.kelimeSonu(p, i, n);
+            if (i < n) {
+                if (p[i] == '.') {
+                    // '1.' de geçerli bir sabittir; nokta her zaman sayıya dahildir
+                    mevcutDurum = LD_SAYI_KESIR;
+                    ++i;
+                } else {
+                    ekle(tokenBaslangic, ofset + i, SAYI);
+                    mevcutDurum = LD_NORMAL;
+                }
+            }
+            break;
+        case LD_SAYI_KESIR:
+            // Rakamlar, 1.5e3'teki üs ve 1.f'deki son ek (noktadan sonra rakam olmasa da)
+            i = cekirdek.kelimeSonu(p, i, n);
+            if (i < n) {
+                ekle(tokenBaslangic, ofset + i, SAYI);
+                mevcutDurum = LD_NORMAL;
+            }
+            break;
+        case LD_BOLU:
+            if (p[i] == '/') {
+                mevcutDurum = LD_SATIR_YORUM;
+                ++i;
+            } else if (p[i] == '*') {
+                mevcutDurum = LD_BLOK_YORUM;
+                ++i;
+            } else {
+                ekle(tokenBaslangic, tokenBaslangic + 1, OPERATOR);
+                mevcutDurum = LD_NORMAL;
+            }
+            break;
+        case LD_SATIR_YORUM: {
+            // Satır sonu yoruma dahil değil
+            const char *son = static_cast<const char *>(std::memchr(p + i, '\n', n - i));
+            if (son) {
+                i = son - p;
+                ekle(tokenBaslangic, ofset + i, YORUM);
+                mevcutDurum = LD_NORMAL;
+            } else {
+                i = n;
+            }
+            break;
+        }
+        case LD_BLOK_YORUM: {
+            size_t yildiz = cekirdek.yorumSonu(p, i, n);
+            if (yildiz < n) {
+                i = yildiz + 2;
+                ekle(tokenBaslangic, ofset + i, YORUM);
+                mevcutDurum = LD_NORMAL;
+            } else {
+                // Parçanın son baytı '*' ise kapanış sonraki parçada olabilir
+                if (p[n - 1] == '*') mevcutDurum = LD_BLOK_YORUM_YILDIZ;
+                i = n;
+            }
+            break;
+        }
+        case LD_BLOK_YORUM_YILDIZ:
+            if (p[i] == '/') {
+                ekle(tokenBaslangic, ofset + i + 1, YORUM);
+                mevcutDurum = LD_NORMAL;
+            } else if (p[i] != '*') {
+                mevcutDurum = LD_BLOK_YORUM;
+            }
+            ++i;
+            break;
+        case LD_METIN:
+        case LD_KARAKTER: {
+            const char kapanis = mevcutDurum == LD_METIN ? '"' : '\'';
+            i = cekirdek.metinDuragi(p, i, n, kapanis);
+            if (i == n) break;
+            TokenTipi tip = mevcutDurum == LD_METIN ? METIN : KARAKTER;
+            if (p[i] == kapanis) {
+                ekle(tokenBaslangic, ofset + i + 1, tip);
+                mevcutDurum = LD_NORMAL;
+                ++i;
+            } else if (p[i] == '\\') {
+                mevcutDurum = mevcutDurum == LD_METIN ? LD_METIN_KACIS : LD_KARAKTER_KACIS;
+                ++i;
+            } else {
+                // Kapanmamış metin satır sonunda biter
+                ekle(tokenBaslangic, ofset + i, tip);
+                mevcutDurum = LD_NORMAL;
+            }
+            break;
+        }
+        case LD_METIN_KACIS:
+            // Kaçış karakteri satır sonunu da kapsar (satır devamı)
+            mevcutDurum = LD_METIN;
+            ++i;
+            break;
+        case LD_KARAKTER_KACIS:
+            mevcutDurum = LD_KARAKTER;
+            ++i;
+            break;
+        }
+    }
+    ofset += n;
+}
+
+void Lexer::bitir() {
+    switch (mevcutDurum) {
+    case LD_NORMAL:
+        break;
+    case LD_TANIMLAYICI:
+        kelimeyiKapat(ofset);
+        break;
+    case LD_SAYI:
+    case LD_SAYI_KESIR:
+        ekle(tokenBaslangic, ofset, SAYI);
+        break;
+    case LD_BOLU:
+        ekle(tokenBaslangic, tokenBaslangic + 1, OPERATOR);
+        break;
+    case LD_SATIR_YORUM:
+    case LD_BLOK_YORUM:
+    case LD_BLOK_YORUM_YILDIZ:
+        // Kapanmamış blok yorum metnin sonuna kadar sürer
+        ekle(tokenBaslangic, ofset, YORUM);
+        break;
+    case LD_METIN:
+    case LD_METIN_KACIS:
+        ekle(tokenBaslangic, ofset, METIN);
+        break;
+    case LD_KARAKTER:
+    case LD_KARAKTER_KACIS:
+        ekle(tokenBaslangic, ofset, KARAKTER);
+        break;
+    }
+    mevcutDurum = LD_NORMAL;
+    tokenBaslangic = ofset;
+}
+
+void tokenizeMetin(const char *metin, size_t uzunluk, std::vector<Token> &tokenlar) {
+    Lexer lexer(tokenlar);
+    lexer.besle(metin, uzunluk);
+    lexer.bitir();
+}
+
+void stilleriHesapla(const TokenDeposu &tokenlar, int baslangic, int bitis, std::string &stil) {
+    // Önce aralığı tanımlayıcı rengiyle doldur
+    stil.assign(bitis - baslangic, 'A' + TANIMLAYICI);
+    // Aralığın başını içine alan token, yoksa aralıkta başlayan ilk token
+    size_t i = tokenlar.konumdakiToken(baslangic);
+    if (i == tokenlar.size()) i = tokenlar.ilkToken(baslangic);
+    // Aralığa düşen her token için uygun rengi uygula
+    for (; i < tokenlar.size() && tokenlar.baslangic(i) < bitis; ++i) {
+        TokenTipi tip = tokenlar.tip(i);
+        if (tip == BOSLUK) continue;  // Boşlukları atla
+        int bas = std::max(tokenlar.baslangic(i), baslangic);
+        int son = std::min(tokenlar.bitis(i), bitis);
+        std::fill(stil.begin() + (bas - baslangic), stil.begin() + (son - baslangic), (char)('A' + tip));
+    }
+}
+
+uint32_t TokenDeposu::tasanUzunluk(size_t i) const {
+    return std::lower_bound(tasanlar.begin(), tasanlar.end(), std::make_pair((uint32_t)i, (uint32_t)0))->second;
+}
+
+size_t TokenDeposu::konumdakiToken(int konum) const {
+    if (konum < 0) return size();
+    // Başlangıcı konumdan büyük olmayan son token
+    size_t i = std::upper_bound(baslangiclar.begin(), baslangiclar.end(), (uint32_t)konum) - baslangiclar.begin();
+    if (i == 0 || konum >= bitis(i - 1)) return size();
+    return i - 1;
+}
+
+void TokenDeposu::tokenEkle(const Token &t) {
+    uint32_t u = (uint32_t)(t.bitis - t.baslangic);
+    if (u >= TASMA) tasanlar.push_back({(uint32_t)baslangiclar.size(), u});
+    baslangiclar.push_back((uint32_t)t.baslangic);
+    uzunluklar.push_back(u >= TASMA ? TASMA : (uint16_t)u);
+    tipler.push_back((uint8_t)t.tip);
+}
+
+void TokenDeposu::clear() {
+    baslangiclar.clear();
+    uzunluklar.clear();
+    tipler.clear();
+    tasanlar.clear();
+}
+
+void TokenDeposu::assign(const Token *t, size_t n) {
+    clear();
+    baslangiclar.reserve(n);
+    uzunluklar.reserve(n);
+    tipler.reserve(n);
+    for (size_t i = 0; i < n; ++i) tokenEkle(t[i]);
+}
+
+void TokenDeposu::ekle(const std::vector<Token> &yeni) {
+    for (const Token &t : yeni) tokenEkle(t);
+}
+
+void TokenDeposu::degistir(size_t bas, size_t son, const std::vector<Token> &yeni) {
+    // Yeni token'lar önce ayrı bir depoda sütunlara ayrılır
+    TokenDeposu ara;
+    ara.ekle(yeni);
+    araligiDegistir(baslangiclar, bas, son, ara.baslangiclar);
+    araligiDegistir(uzunluklar, bas, son, ara.uzunluklar);
+    araligiDegistir(tipler, bas, son, ara.tipler);
+    // Değişen aralığın taşma kayıtları yenileriyle değişir, sonrakilerin indeksi kayar
+    auto kayit = [](const std::pair<uint32_t, uint32_t> &k, uint32_t i) { return k.first < i; };
+    size_t ilk = std::lower_bound(tasanlar.begin(), tasanlar.end(), (uint32_t)bas, kayit) - tasanlar.begin();
+    size_t sonKayit = std::lower_bound(tasanlar.begin() + ilk, tasanlar.end(), (uint32_t)son, kayit) - tasanlar.begin();
+    for (std::pair<uint32_t, uint32_t> &k : ara.tasanlar) k.first += (uint32_t)bas;
+    araligiDegistir(tasanlar, ilk, sonKayit, ara.tasanlar);
+    const uint32_t fark = (uint32_t)(yeni.size() - (son - bas));  // İşaretsiz taşma ile negatif fark
+    for (size_t i = ilk + ara.tasanlar.size(); i < tasanlar.size(); ++i) tasanlar[i].first += fark;
+}
+
+void TokenDeposu::kaydir(size_t bas, int fark) {
+    for (size_t i = bas; i < baslangiclar.size(); ++i) baslangiclar[i] += (uint32_t)fark;
+}
+
+void TokenDeposu::kopyala(std::vector<Token> &hedef) const {
+    hedef.resize(size());
+    for (size_t i = 0; i < hedef.size(); ++i) {
+        hedef[i] = Token{(int)baslangiclar[i], (int)(baslangiclar[i] + uzunluklar[i]), (TokenTipi)tipler[i]};
+    }
+    for (const std::pair<uint32_t, uint32_t> &k : tasanlar) hedef[k.first].bitis = hedef[k.first].baslangic + (int)k.second;
+}
+
+void TokenDeposu::ekleKopyala(size_t bas, size_t son, std::vector<Token> &hedef) const {
+    hedef.reserve(hedef.size() + (son - bas));
+    for (size_t i = bas; i < son; ++i) hedef.push_back((*this)[i]);
+}
+
+void TokenDeposu::sikistir() {
+    // Eklenen token'lar kapasiteyi ikiye katlayarak büyütür; lexleme bitince
+    // boyutun 1/16'sı kadar pay bırakılır ki ilk düzenlemeler yeniden ayırmasın
+    size_t pay = size() / 16;
+    kapasiteyiKirp(baslangiclar, pay);
+    kapasiteyiKirp(uzunluklar, pay);
+    kapasiteyiKirp(tipler, pay);
+    kapasiteyiKirp(tasanlar, tasanlar.size() / 16);
+}
+
+size_t TokenDeposu::bellek() const {
+    return baslangiclar.capacity() * sizeof(uint32_t) + uzunluklar.capacity() * sizeof(uint16_t) +
+           tipler.capacity() * sizeof(uint8_t) + tasanlar.capacity() * sizeof(tasanlar[0]);
+}
+
+void ArtimliLexer::sifirla(int uzunluk) {
+    tokenlar.clear();
+    satirlar.clear();
+    satirlar.push_back({0, LD_NORMAL});
+    metinUzunlugu = uzunluk;
+    lexSiniri = 0;
+    tamam = false;
+}
+
+void ArtimliLexer::tamamen(const MetinKaynagi &kaynak) {
+    sifirla((int)kaynak.uzunluk());
+    ilerlet(kaynak, INT_MAX);
+}
+
+void ArtimliLexer::baslat(const MetinKaynagi &kaynak, int hedef) {
+    sifirla((int)kaynak.uzunluk());
+    ilerlet(kaynak, hedef);
+}
+
+DegisimAraligi ArtimliLexer::ilerlet(const MetinKaynagi &kaynak, int hedef) {
+    const int baslangic = lexSiniri;
+    if (tamam || (baslangic >= hedef && baslangic < metinUzunlugu)) {
+        return DegisimAraligi{baslangic, baslangic, baslangic};
+    }
+
+    // Sınırdaki satır kaydı zaten var ve temiz; lexleme oradan sürer
+    std::vector<Token> yeniTokenlar;
+    Lexer lexer(yeniTokenlar);
+    lexer.sifirla(baslangic);
+    bool durdu = satirSatirLexle(kaynak, lexer, baslangic, metinUzunlugu, OKUMA_BLOGU, [&](int satirBasi) {
+        satirlar.push_back({satirBasi, lexer.durum()});
+        return satirBasi >= hedef && satirBasi < metinUzunlugu && lexer.durum() == LD_NORMAL;
+    });
+    if (durdu) {
+        lexSiniri = (int)lexer.konum();
+    } else {
+        lexer.bitir();
+        lexSiniri = metinUzunlugu;
+        tamam = true;
+    }
+    tokenlar.ekle(yeniTokenlar);
+    if (tamam) tokenlar.sikistir();
+    return DegisimAraligi{baslangic, lexSiniri, lexSiniri};
+}
+
+DegisimAraligi ArtimliLexer::guncelle(const MetinKaynagi &kaynak, int pos, int nInserted, int nDeleted) {
+    const int fark = nInserted - nDeleted;
+    const int duzenlemeSonu = pos + nInserted;
+    const int yeniUzunluk = (int)kaynak.uzunluk();
+
+    // Lexlenmemiş kısımdaki düzenleme hiçbir token'ı değiştirmez; sınırdan
+    // önceki metin sınırdan sonrakine bağlı değildir
+    if (!tamam && pos >= lexSiniri) {
+        metinUzunlugu = yeniUzunluk;
+        return DegisimAraligi{pos, pos + nDeleted, duzenlemeSonu};
+    }
+    // Eski metinde token'ların geçerli olduğu kısmın sonu
+    const int eskiSinir = tamam ? metinUzunlugu : lexSiniri;
+
+    // Düzenlemenin olduğu satırdan geriye doğru, başında hiçbir token'ın
+    // açık olmadığı ilk satırı bul; yeniden lexleme oradan başlar
+    size_t ilkSatir = std::upper_bound(satirlar.begin(), satirlar.end(), pos,
+                                       [](int konum, const SatirKaydi &s) { return konum < s.baslangic; })
+                      - satirlar.begin() - 1;
+    while (ilkSatir > 0 && satirlar[ilkSatir].durum != LD_NORMAL) --ilkSatir;
+    const int baslangic = satirlar[ilkSatir].baslangic;
+
+    std::vector<Token> yeniTokenlar;
+    std::vector<SatirKaydi> yeniSatirlar;
+    Lexer lexer(yeniTokenlar);
+    lexer.sifirla(baslangic);
+
+    size_t sonSatir = satirlar.size();  // Aynen korunacak ilk eski satır
+    int yeniBitis = yeniUzunluk;
+    bool yakinsadi = false, kesildi = false;
+    satirSatirLexle(kaynak, lexer, baslangic, yeniUzunluk, OKUMA_BLOGU, [&](int satirBasi) {
+        if (lexer.durum() == LD_NORMAL) {
+            // Düzenlemeden sonraki değişmemiş metinde iki akış da temizse yakınsamıştır
+            if (satirBasi > duzenlemeSonu) {
+                int eskiSatirBasi = satirBasi - fark;
+                auto eski = std::lower_bound(satirlar.begin() + ilkSatir + 1, satirlar.end(), eskiSatirBasi,
+                                             [](const SatirKaydi &s, int konum) { return s.baslangic < konum; });
+                if (eski != satirlar.end() && eski->baslangic == eskiSatirBasi && eski->durum == LD_NORMAL) {
+                    sonSatir = eski - satirlar.begin();
+                    yeniBitis = satirBasi;
+                    yakinsadi = true;
+                    return true;
+                }
+            }
+            // Bütçe bittiyse bu satır yeni sınır olur; gerisi sonra lexlenir
+            if (butce > 0 && satirBasi - baslangic >= butce && satirBasi < yeniUzunluk) {
+                yeniSatirlar.push_back({satirBasi, LD_NORMAL});
+                yeniBitis = satirBasi;
+                kesildi = true;
+                return true;
+            }
+        }
+        yeniSatirlar.push_back({satirBasi, lexer.durum()});
+        return false;
+    });
+    if (!yakinsadi && !kesildi) lexer.bitir();
+
+    // Eski token'ların yeniden lexlenen kısmını yenileriyle değiştir, sonrakileri kaydır
+    // Yakınsamadıysa eski token'ların hepsi değişir ve aralık eski sınıra kadar uzar
+    int eskiBitis = yeniBitis - fark;
+    if (!yakinsadi) eskiBitis = std::max(eskiBitis, std::max(eskiSinir, pos + nDeleted));
+    size_t ilkToken = tokenlar.ilkToken(baslangic);
+    size_t sonToken = yakinsadi ? tokenlar.ilkToken(eskiBitis) : tokenlar.size();
+    tokenlar.degistir(ilkToken, sonToken, yeniTokenlar);
+    if (fark != 0) tokenlar.kaydir(ilkToken + yeniTokenlar.size(), fark);
+
+    // Satır kayıtlarını da aynı şekilde güncelle
+    araligiDegistir(satirlar, ilkSatir + 1, sonSatir, yeniSatirlar);
+    if (fark != 0) {
+        for (size_t i = ilkSatir + 1 + yeniSatirlar.size(); i < satirlar.size(); ++i) {
+            satirlar[i].baslangic += fark;
+        }
+    }
+
+    if (kesildi) {
+        lexSiniri = yeniBitis;
+        tamam = false;
+    } else if (yakinsadi) {
+        lexSiniri = eskiSinir + fark;
+    } else {
+        lexSiniri = yeniUzunluk;
+        tamam = true;
+    }
+    metinUzunlugu = yeniUzunluk;
+    return DegisimAraligi{baslangic, eskiBitis, eskiBitis + fark};
+}
+
+DegisimAraligi degisimleriBirlestir(const DegisimAraligi &once, const DegisimAraligi &sonra) {
+    const int ilkFark = once.yeniBitis - once.eskiBitis;
+    const int ikinciFark = sonra.yeniBitis - sonra.eskiBitis;
+    DegisimAraligi birlesik;
+    // İkinci aralıktan önceki konumlar her iki düzenlemede de değişmemiştir
+    birlesik.baslangic = std::min(once.baslangic, sonra.baslangic);
+    // Eski metindeki bitiş: ilk aralığın sonu ya da ikinci aralığın sonunun
+    // ilk düzenlemeden önceki karşılığı
+    birlesik.eskiBitis = sonra.eskiBitis >= once.yeniBitis
+        ? std::max(once.eskiBitis, sonra.eskiBitis - ilkFark)
+        : once.eskiBitis;
+    // Yeni metindeki bitiş: ikinci aralığın sonu ya da ilk aralığın sonunun
+    // ikinci düzenlemeden sonraki karşılığı
+    birlesik.yeniBitis = once.yeniBitis >= sonra.eskiBitis
+        ? std::max(sonra.yeniBitis, once.yeniBitis + ikinciFark)
+        : sonra.yeniBitis;
+    return birlesik;
+}
+
+void TokenAkisi::kaydet(const DegisimAraligi &degisim) {
+    if (gecmis.size() < GECMIS_SINIRI) gecmis.resize(GECMIS_SINIRI);
+    gecmis[surum % GECMIS_SINIRI] = degisim;
+}
+
+TokenAkisi::TokenAkisi(Belge &b) : belge(b), lexer(tokenlar), surum(0) {}
+
+void TokenAkisi::yenidenOlustur() {
+    int eskiUzunluk = lexer.getMetinUzunlugu();
+    ++surum;
+    lexer.tamamen(belge);
+    // Bütün metin değişmiş sayılır
+    kaydet(DegisimAraligi{0, eskiUzunluk, lexer.getMetinUzunlugu()});
+}
+
+void TokenAkisi::baslat(int hedef) {
+    int eskiUzunluk = lexer.getMetinUzunlugu();
+    ++surum;
+    lexer.baslat(belge, hedef);
+    kaydet(DegisimAraligi{0, eskiUzunluk, lexer.getMetinUzunlugu()});
+}
+
+DegisimAraligi TokenAkisi::ilerlet(int hedef) {
+    return lexer.ilerlet(belge, hedef);
+}
+
+void TokenAkisi::tamamla() {
+    lexer.ilerlet(belge, INT_MAX);
+}
+
+void TokenAkisi::yukle(const Token *t, size_t tokenSayisi, const SatirKaydi *s, size_t satirSayisi) {
+    int eskiUzunluk = lexer.getMetinUzunlugu();
+    ++surum;
+    lexer.yukle(t, tokenSayisi, s, satirSayisi, (int)belge.uzunluk());
+    kaydet(DegisimAraligi{0, eskiUzunluk, lexer.getMetinUzunlugu()});
+}
+
+DegisimAraligi TokenAkisi::duzenle(int pos, int nDeleted, const char *eklenen, int nInserted) {
+    ++surum;
+    belge.degistir(pos, nDeleted, eklenen, nInserted);
+    DegisimAraligi degisim = lexer.guncelle(belge, pos, nInserted, nDeleted);
+    kaydet(degisim);
+    return degisim;
+}
+
+bool TokenAkisi::degisimlerSonra(unsigned long eskiRevizyon, DegisimAraligi &birlesik) const {
+    if (eskiRevizyon >= surum || surum - eskiRevizyon > GECMIS_SINIRI) return false;
+    birlesik = gecmis[(eskiRevizyon + 1) % GECMIS_SINIRI];
+    for (unsigned long r = eskiRevizyon + 2; r <= surum; ++r) {
+        birlesik = degisimleriBirlestir(birlesik, gecmis[r % GECMIS_SINIRI]);
+    }
+    return true;
+}
+
+size_t TokenAkisi::satirNo(int konum) const {
+    const std::vector<SatirKaydi> &satirlar = lexer.getSatirlar();
+    return std::upper_bound(satirlar.begin(), satirlar.end(), konum,
+                            [](int k, const SatirKaydi &s) { return k < s.baslangic; })
+           - satirlar.begin() - 1;
+}
+
+std::pair<size_t, size_t> TokenAkisi::satirTokenlari(size_t satir) const {
+    const std::vector<SatirKaydi> &satirlar = lexer.getSatirlar();
+    if (satir >= satirlar.size()) return {tokenlar.size(), tokenlar.size()};
+    size_t ilk = tokenlar.ilkToken(satirlar[satir].baslangic);
+    size_t son = satir + 1 < satirlar.size() ? tokenlar.ilkToken(satirlar[satir + 1].baslangic) : tokenlar.size();
+    return {ilk, son};
+}
+
+BelgeGoruntusu TokenAkisi::goruntu() const {
+    return belge.goruntu();
+}
+
+std::string TokenAkisi::tokenMetni(const Token &token) const {
+    std::string metin;
+    belge.oku(token.baslangic, token.bitis, metin);
+    return metin;
+}
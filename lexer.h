@@ -0,0 +1,311 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Token tiplerini tanımlayan enum
+// Her token tipi için bir renk ve stil atanacak
+enum TokenTipi {
+    ANAHTAR_KELIME = 0,  // if, else, while gibi C++ anahtar kelimeleri
+    TANIMLAYICI,         // Değişken ve fonksiyon isimleri
+    SAYI,                // Sayısal değerler (tam sayı ve ondalıklı)
+    OPERATOR,            // +, -, *, /, =, ==, != gibi operatörler
+    METIN,               // Çift tırnak içindeki string'ler
+    KARAKTER,            // Tek tırnak içindeki karakterler
+    YORUM,               // // veya /* */ içindeki yorumlar
+    BOSLUK,              // Boşluk, tab ve satır sonları
+    NOKTALAMA,           // (, ), {, }, ;, , gibi ayraçlar
+};
+
+// Her token için gerekli bilgileri tutan yapı
+struct Token {
+    int baslangic;       // Token'ın metin içindeki başlangıç pozisyonu
+    int bitis;           // Token'ın metin içindeki bitiş pozisyonu
+    TokenTipi tip;       // Token'ın tipi
+};
+
+// Lexer'ın iki karakter arasında bulunabileceği durumlar
+// Durum makinesi her karakterde bu durumlardan birine geçer
+enum LexDurumu : uint8_t {
+    LD_NORMAL = 0,          // Hiçbir token'ın içinde değil
+    LD_TANIMLAYICI,         // Tanımlayıcı veya anahtar kelime okunuyor
+    LD_SAYI,                // Sayının tam kısmı okunuyor
+    LD_SAYI_KESIR,          // Sayının '.' ve sonrası (ondalık kısım, üs, son ek) okunuyor
+    LD_BOLU,                // '/' görüldü, yorum mu operatör mü belli değil
+    LD_SATIR_YORUM,         // // yorumunun içinde
+    LD_BLOK_YORUM,          // /* */ yorumunun içinde
+    LD_BLOK_YORUM_YILDIZ,   // Blok yorumda '*' görüldü, '/' bekleniyor
+    LD_METIN,               // Çift tırnaklı metnin içinde
+    LD_METIN_KACIS,         // Metinde '\' görüldü
+    LD_KARAKTER,            // Tek tırnaklı karakterin içinde
+    LD_KARAKTER_KACIS       // Karakterde '\' görüldü
+};
+
+// Tek geçişli, tablo güdümlü lexer
+// Metin herhangi bir yerden bölünmüş parçalar halinde beslenebilir;
+// parçalar arasında kalan yarım token'lar durum olarak saklanır
+class Lexer {
+public:
+    explicit Lexer(std::vector<Token> &cikti) : tokenlar(cikti) { sifirla(0); }
+
+    // Lexer'ı verilen konumda temiz (LD_NORMAL) durumda başlatır
+    void sifirla(size_t ofset);
+    // Bir metin parçasını işler; parça metinde 'konum()'dan başlar
+    void besle(const char *parca, size_t uzunluk);
+    // Metnin sonuna gelindiğinde açık kalan token'ı kapatır
+    void bitir();
+
+    LexDurumu durum() const { return mevcutDurum; }
+    size_t konum() const { return ofset; }
+
+    // Bundan sonra üretilecek token'ların konumlarını yeni bir tabana göre
+    // yazdırır ve tabanı döndürür. Taban, açık token'ın (yoksa sıradaki
+    // token'ın) başlangıcıdır. Üretilen token'lar boşaltıldıktan sonra
+    // çağrılırsa çok büyük metinlerde de Token'ın 32 bitlik alanları taşmaz;
+    // yalnızca tek bir token'ın 2 GB'tan kısa olması gerekir.
+    size_t tabaniIlerlet() {
+        taban = mevcutDurum == LD_NORMAL ? ofset : tokenBaslangic;
+        return taban;
+    }
+
+private:
+    // Anahtar kelime kontrolü için tutulan en uzun kelime
+    static const size_t KELIME_SINIRI = 16;
+
+    std::vector<Token> &tokenlar;   // Üretilen token'ların yazıldığı liste
+    LexDurumu mevcutDurum;          // Son işlenen karakterden sonraki durum
+    size_t ofset;                   // Sıradaki parçanın metin içindeki konumu
+    size_t tokenBaslangic;          // Açık token'ın başlangıcı
+    char kelime[KELIME_SINIRI];     // Okunan tanımlayıcının ilk karakterleri
+    size_t kelimeUzunlugu;          // Okunan tanımlayıcının toplam uzunluğu
+    size_t taban;                   // Token konumlarının göreli yazıldığı metin konumu
+
+    void ekle(size_t baslangic, size_t bitis, TokenTipi tip) {
+        tokenlar.push_back(Token{(int)(baslangic - taban), (int)(bitis - taban), tip});
+    }
+    void kelimeyiKapat(size_t bitis);
+};
+
+// Artımlı lexer'ın metni okuduğu kaynak
+// Düzenleyicideki buffer gibi metni tek parça tutmayan kaynaklar için kullanılır
+class MetinKaynagi {
+public:
+    virtual ~MetinKaynagi() {}
+    virtual size_t uzunluk() const = 0;
+    // [baslangic, bitis) aralığındaki metni hedefe kopyalar
+    virtual void oku(size_t baslangic, size_t bitis, std::string &hedef) const = 0;
+};
+
+// Her satırın başlangıcı ve o noktadaki lexer durumu
+// Satır başında yalnızca LD_NORMAL, LD_BLOK_YORUM, LD_METIN veya LD_KARAKTER olabilir
+struct SatirKaydi {
+    int baslangic;
+    LexDurumu durum;
+};
+
+// Bir düzenlemeden sonra token'ları değişen metin aralığı
+// baslangic her iki metinde aynıdır; eskiBitis eski, yeniBitis yeni metindeki sınırdır
+struct DegisimAraligi {
+    int baslangic;
+    int eskiBitis;
+    int yeniBitis;
+};
+
+// Token'ları sütun sütun (structure of arrays) saklayan sıkı liste
+// Token başına 7 bayt tutulur: 32 bitlik başlangıç, 16 bitlik uzunluk ve
+// 8 bitlik tip (Token'ın kendisi 12 bayttır). 65535 bayt ve daha uzun token'ların
+// (ör. büyük blok yorumlar) uzunluğu ayrı bir taşma tablosunda tutulur.
+// Başlangıçlar sıralı olduğu için konuma göre sorgular ikili aramadır.
+class TokenDeposu {
+public:
+    size_t size() const { return baslangiclar.size(); }
+    bool empty() const { return baslangiclar.empty(); }
+    int baslangic(size_t i) const { return (int)baslangiclar[i]; }
+    int bitis(size_t i) const { return (int)(baslangiclar[i] + uzunluk(i)); }
+    TokenTipi tip(size_t i) const { return (TokenTipi)tipler[i]; }
+    Token operator[](size_t i) const { return Token{baslangic(i), bitis(i), tip(i)}; }
+
+    // Başlangıcı 'konum'dan küçük olmayan ilk token'ın indeksi
+    size_t ilkToken(int konum) const {
+        return std::lower_bound(baslangiclar.begin(), baslangiclar.end(), (uint32_t)std::max(konum, 0)) -
+               baslangiclar.begin();
+    }
+    // 'konum'daki karakteri içeren token'ın indeksi; yoksa size()
+    size_t konumdakiToken(int konum) const;
+
+    void clear();
+    void assign(const Token *t, size_t n);
+    // Token'ları listenin sonuna ekler
+    void ekle(const std::vector<Token> &yeni);
+    // [bas, son) token'larını 'yeni' ile değiştirir
+    void degistir(size_t bas, size_t son, const std::vector<Token> &yeni);
+    // 'bas' indeksinden sonraki token'ları metinde 'fark' kadar kaydırır
+    void kaydir(size_t bas, int fark);
+    // Token'ları düz bir listeye açar (ör. parser için)
+    void kopyala(std::vector<Token> &hedef) const;
+    // [bas, son) token'larını düz listenin sonuna ekler
+    void ekleKopyala(size_t bas, size_t son, std::vector<Token> &hedef) const;
+    // Sütunların fazla kapasitesini bırakır; düzenlemeler için küçük bir pay kalır
+    void sikistir();
+    // Kullanılan bellek (bayt)
+    size_t bellek() const;
+
+private:
+    // Uzunluğu taşma tablosunda olan token'ın uzunluk sütunundaki değeri
+    static const uint16_t TASMA = 0xFFFF;
+
+    std::vector<uint32_t> baslangiclar;
+    std::vector<uint16_t> uzunluklar;
+    std::vector<uint8_t> tipler;
+    std::vector<std::pair<uint32_t, uint32_t>> tasanlar;  // (indeks, uzunluk), indekse göre sıralı
+
+    uint32_t uzunluk(size_t i) const {
+        return uzunluklar[i] != TASMA ? uzunluklar[i] : tasanUzunluk(i);
+    }
+    uint32_t tasanUzunluk(size_t i) const;
+    void tokenEkle(const Token &t);
+};
+
+// Token listesini düzenlemelere göre artımlı olarak güncel tutar
+// Her satır başındaki lexer durumunu saklar; bir düzenlemeden sonra
+// düzenlemeden önceki son temiz (LD_NORMAL) satırdan yeniden lexler ve
+// durum eski token akışıyla yakınsadığı anda durur
+//
+// Metnin yalnızca başı lexlenmiş olabilir: token'lar ve satır kayıtları
+// 'lexSiniri'ne kadar geçerlidir, gerisi ilerlet() ile sırası gelince lexlenir.
+// Sınır her zaman lexer'ın temiz olduğu bir satır başıdır; sınırın ötesindeki
+// düzenlemeler token'ları değiştirmez.
+class ArtimliLexer {
+public:
+    explicit ArtimliLexer(TokenDeposu &liste)
+        : tokenlar(liste), metinUzunlugu(0), lexSiniri(0), tamam(true), butce(0) {
+        satirlar.push_back({0, LD_NORMAL});
+    }
+
+    // Bütün metni baştan token'lara ayırır
+    void tamamen(const MetinKaynagi &kaynak);
+    // Metni baştan, en az 'hedef' konumuna kadar token'lara ayırır; gerisi ilerlet() ile lexlenir
+    void baslat(const MetinKaynagi &kaynak, int hedef);
+    // Lexlenmiş kısmı en az 'hedef' konumuna (veya metnin sonuna) kadar uzatır
+    // ve yeni token'ların aralığını döndürür
+    DegisimAraligi ilerlet(const MetinKaynagi &kaynak, int hedef);
+    // [pos, pos + nDeleted) aralığı silinip yerine nInserted karakter eklendikten
+    // sonra token'ları günceller ve token'ları değişen aralığı döndürür
+    // Bütçe verilmişse ve akış o kadar bayt içinde yakınsamazsa geri kalanı
+    // lexlenmemiş sayılır ve aralık eski lexleme sınırına kadar uzanır
+    DegisimAraligi guncelle(const MetinKaynagi &kaynak, int pos, int nInserted, int nDeleted);
+    // Daha önce aynı metinden üretilmiş token'ları ve satır kayıtlarını lexlemeden yükler
+    void yukle(const Token *t, size_t tokenSayisi, const SatirKaydi *s, size_t satirSayisi, int uzunluk) {
+        tokenlar.assign(t, tokenSayisi);
+        satirlar.assign(s, s + satirSayisi);
+        metinUzunlugu = lexSiniri = uzunluk;
+        tamam = true;
+    }
+    // Bir düzenlemeden sonra yeniden lexlenecek en fazla bayt (0: sınırsız)
+    void setButce(int bayt) { butce = bayt; }
+
+    const std::vector<SatirKaydi> &getSatirlar() const { return satirlar; }
+    int getMetinUzunlugu() const { return metinUzunlugu; }
+    int getLexSiniri() const { return lexSiniri; }
+    bool tamamlandi() const { return tamam; }
+
+private:
+    // Kaynaktan bir seferde okunan parça boyutu
+    static const size_t OKUMA_BLOGU = 4096;
+
+    TokenDeposu &tokenlar;            // Güncel tutulan token listesi
+    std::vector<SatirKaydi> satirlar; // Her satırın başlangıç kaydı
+    int metinUzunlugu;                // Son güncellemedeki metin uzunluğu
+    int lexSiniri;                    // Token'ların geçerli olduğu kısmın sonu
+    bool tamam;                       // Metnin sonuna kadar lexlendi mi
+    int butce;                        // Düzenleme başına yeniden lexleme sınırı
+
+    void sifirla(int uzunluk);
+};
+
+class Belge;
+class BelgeGoruntusu;
+
+// Bir belgenin tek token akışı
+// Her düzenleme yalnızca bir kez lexlenir; vurgulayıcı, lexical analiz penceresi
+// ve parser aynı akışı okur. Metin hiçbir zaman bütünüyle kopyalanmaz; okuyucular
+// belgenin değişmez bir görüntüsünü alır (belge.h).
+class TokenAkisi {
+public:
+    explicit TokenAkisi(Belge &b);
+
+    // Belgenin bütün metnini baştan token'lara ayırır
+    void yenidenOlustur();
+    // Belgeyi baştan yalnızca 'hedef' konumuna kadar token'lara ayırır;
+    // yenidenOlustur() gibi yeni bir revizyon açar
+    void baslat(int hedef);
+    // Lexlenmiş kısmı en az 'hedef' konumuna kadar uzatır ve yeni token'ların aralığını döndürür
+    // Revizyon değişmez: sınırın ötesinde token yoktu, yalnızca eksik kısım doldurulur
+    DegisimAraligi ilerlet(int hedef);
+    // Belgenin lexlenmemiş kısmını lexler
+    void tamamla();
+    // Token'ların geçerli olduğu kısmın sonu; tamamlandi() ise metnin uzunluğu
+    int lexSiniri() const { return lexer.getLexSiniri(); }
+    bool tamamlandi() const { return lexer.tamamlandi(); }
+    // Bir düzenlemeden sonra yeniden lexlenecek en fazla bayt (0: sınırsız)
+    // Aşılırsa belgenin geri kalanı ilerlet() çağrılana kadar lexlenmemiş kalır
+    void setButce(int bayt) { lexer.setButce(bayt); }
+    // [pos, pos + nDeleted) aralığını belgeden silip yerine 'eklenen'in ilk
+    // nInserted baytını ekler ve token'ları değişen aralığı döndürür
+    DegisimAraligi duzenle(int pos, int nDeleted, const char *eklenen, int nInserted);
+    // Kaynağın güncel metninden daha önce üretilmiş token'ları ve satır
+    // kayıtlarını (ör. önbellekten) yükler; yenidenOlustur() gibi yeni bir revizyon açar
+    void yukle(const Token *t, size_t tokenSayisi, const SatirKaydi *s, size_t satirSayisi);
+
+    // Her düzenlemede artan belge revizyonu
+    unsigned long revizyon() const { return surum; }
+    // 'eskiRevizyon'dan bu yana token'ları değişen bütün aralıkları tek bir
+    // aralıkta birleştirir; o revizyondan beri düzenleme yoksa veya geçmiş
+    // o kadar eskiye gitmiyorsa false döndürür
+    bool degisimlerSonra(unsigned long eskiRevizyon, DegisimAraligi &birlesik) const;
+    const TokenDeposu &getTokenlar() const { return tokenlar; }
+    const std::vector<SatirKaydi> &getSatirlar() const { return lexer.getSatirlar(); }
+    // 'konum'un bulunduğu satırın indeksi (0'dan başlar)
+    // Satır kayıtları yalnızca lexSiniri()'ne kadar vardır; ötesi son kayıtlı satırda sayılır
+    size_t satirNo(int konum) const;
+    // 'satir' indeksli satırda başlayan token'ların indeks aralığı [ilk, son)
+    std::pair<size_t, size_t> satirTokenlari(size_t satir) const;
+
+    // Mevcut revizyonun metninin değişmez görüntüsü; kopyalamak ucuzdur
+    BelgeGoruntusu goruntu() const;
+    // Token'ın metni
+    std::string tokenMetni(const Token &token) const;
+
+private:
+    // Saklanan en fazla düzenleme sayısı
+    static const size_t GECMIS_SINIRI = 256;
+
+    Belge &belge;                 // Belgenin metni
+    TokenDeposu tokenlar;         // Güncel token listesi
+    ArtimliLexer lexer;           // Token listesini güncel tutan lexer
+    unsigned long surum;          // Belge revizyonu
+    std::vector<DegisimAraligi> gecmis;  // Son düzenlemelerin aralıkları, revizyon % GECMIS_SINIRI sırasıyla
+
+    void kaydet(const DegisimAraligi &degisim);
+};
+
+// Art arda yapılan iki düzenlemenin aralıklarını, ilk düzenlemeden önceki
+// metinden ikinciden sonraki metne giden tek bir aralıkta birleştirir
+DegisimAraligi degisimleriBirlestir(const DegisimAraligi &once, const DegisimAraligi &sonra);
+
+// Verilen kelimenin vurgulanacak bir anahtar kelime olup olmadığını döndürür
+bool anahtarKelimeMi(const char *kelime, size_t uzunluk);
+
+// Bütün metni tek geçişte token'lara ayırır
+void tokenizeMetin(const char *metin, size_t uzunluk, std::vector<Token> &tokenlar);
+
+// [baslangic, bitis) aralığının stil karakterlerini ('A' + TokenTipi) tek bir diziye yazar
+// Token'a düşmeyen karakterler ve boşluklar tanımlayıcı stilini alır
+void stilleriHesapla(const TokenDeposu &tokenlar, int baslangic, int bitis, std::string &stil);
+
+#endif
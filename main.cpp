@@ -4,273 +4,239 @@
 #include <FL/Fl_Text_Buffer.H>
 #include <FL/Fl_Tree.H>
 #include <FL/Fl_Button.H>
+#include <FL/Fl_Toggle_Button.H>
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Native_File_Chooser.H>
+#include <FL/fl_ask.H>
 #include <vector>
 #include <string>
-#include <regex>
 #include <map>
-#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
 #include "FL/forms.H"
-#include "parse_tree.cpp"
-
-
-void metin_degisti_parse_cb(int pos, int nInserted, int nDeleted, int, const char *, void *v);
-void parse_tree_cb(Fl_Widget*, void* v);
-
-// Token tiplerini tanımlayan enum
-// Her token tipi için bir renk ve stil atanacak
-enum TokenTipi {
-    ANAHTAR_KELIME = 0,  // if, else, while gibi C++ anahtar kelimeleri
-    TANIMLAYICI,         // Değişken ve fonksiyon isimleri
-    SAYI,                // Sayısal değerler (tam sayı ve ondalıklı)
-    OPERATOR,            // +, -, *, /, =, ==, != gibi operatörler
-    METIN,               // Çift tırnak içindeki string'ler
-    KARAKTER,            // Tek tırnak içindeki karakterler
-    YORUM,               // // veya /* */ içindeki yorumlar
-    BOSLUK,              // Boşluk, tab ve satır sonları
-};
-
-// Her token için gerekli bilgileri tutan yapı
-struct Token {
-    int baslangic;       // Token'ın metin içindeki başlangıç pozisyonu
-    int bitis;           // Token'ın metin içindeki bitiş pozisyonu
-    TokenTipi tip;       // Token'ın tipi
-};
+#include "dosya_girdisi.h"
+#include "duzenleme_betigi.h"
+#include "lexer.h"
+#include "olcum.h"
+#include "onbellek.h"
+#include "parse_tree.h"
+#include "vurgulayici.h"
 
-// Syntax vurgulama işlemlerini yapan ana sınıf
-class SyntaxVurgulayici {
+// Lexical analiz gösteren pencere sınıfı
+class LexicalAnalizPencere : public Fl_Window {
 private:
-    Fl_Text_Buffer *metinBuffer;           // Düzenlenen metni tutan buffer
-    Fl_Text_Buffer *stilBuffer;            // Renk ve stil bilgilerini tutan buffer
-    std::vector<Token> tokenlar;           // Bulunan tüm token'ların listesi
-    std::map<TokenTipi, Fl_Color> renkHaritasi;  // Token tiplerine göre renk eşleştirmeleri
-    // C++ anahtar kelimeleri listesi
-    std::vector<std::string> anahtarKelimeler = {"if", "else", "while", "for", "return", "int", "float", "void", "char", "string"};
-    // Token tiplerini bulmak için kullanılan regex desenleri
-    std::regex anahtarKelimeRegex;    // Anahtar kelimeleri bulmak için
-    std::regex tanimlayiciRegex;      // Değişken/fonksiyon isimlerini bulmak için
-    std::regex sayiRegex;             // Sayıları bulmak için
-    std::regex operatorRegex;         // Operatörleri bulmak için
-    std::regex metinRegex;            // String'leri bulmak için
-    std::regex karakterRegex;         // Karakterleri bulmak için
-    std::regex yorumRegex;            // Yorumları bulmak için
+    // Bir bloktaki satır sayısı; ağacın ilk düzeyinde yalnızca bloklar bulunur
+    static const size_t BLOK_SATIR = 100;
+    // Ağaçtaki grup türleri; satır numarasıyla birlikte öğenin user_data'sında saklanır
+    enum GrupTuru { GRUP_BLOK = 0, GRUP_SATIR = 1 };
 
-public:
-    // Constructor: Buffer'ı alır ve regex desenlerini hazırlar
-    SyntaxVurgulayici(Fl_Text_Buffer *buf) : metinBuffer(buf) {
-        // Her token tipi için renk tanımlamaları
-        renkHaritasi = {
-            {ANAHTAR_KELIME, FL_RED},        // Anahtar kelimeler kırmızı
-            {TANIMLAYICI, FL_BLACK},         // Tanımlayıcılar siyah
-            {SAYI, FL_BLUE},                 // Sayılar mavi
-            {OPERATOR, FL_DARK_GREEN},       // Operatörler koyu yeşil
-            {METIN, FL_MAGENTA},             // String'ler mor
-            {KARAKTER, FL_DARKGOLD},        // Karakterler altın sarısı
-            {YORUM, FL_GRAY},                // Yorumlar gri
-            {BOSLUK, FL_WHITE}               // Boşluklar beyaz
-        };
-        // Regex desenlerini hazırla
-        anahtarKelimeRegex = std::regex("\\b(" + anahtarKelimeDeseniAl() + ")\\b");
-        tanimlayiciRegex = std::regex("[a-zA-Z_]\\w*");  // Harf veya _ ile başlayan kelimeler
-        sayiRegex = std::regex("\\b\\d+(\\.\\d+)?\\b");  // Tam sayı veya ondalıklı sayı
-        operatorRegex = std::regex("[\\+\\-\\*/%=&|<>!]");  // Temel operatörler
-        metinRegex = std::regex("\"(?:[^\"\\\\]|\\\\.)*\"");  // Çift tırnak içindeki metinler
-        karakterRegex = std::regex("'(?:[^'\\\\]|\\\\.)'");  // Tek tırnak içindeki karakterler
-        yorumRegex = std::regex("(//[^\\n]*)|(/\\*[\\s\\S]*?\\*/)");
-        stilBuffer = new Fl_Text_Buffer();
-    }
-
-    // Anahtar kelimeleri regex desenine dönüştürür
-    std::string anahtarKelimeDeseniAl() {
-        std::string desen;
-        for (size_t i = 0; i < anahtarKelimeler.size(); ++i) {
-            if (i != 0) desen += "|";
-            desen += anahtarKelimeler[i];
-        }
-        return desen;
-    }
-
-    // Metni token'lara ayırır
-    void tokenize() {
-        tokenlar.clear();
-        std::string metin = metinBuffer->text();
-        if (metin.empty()) return;
-        // Önce string'leri bul ve işaretle
-        std::vector<std::pair<int, int>> stringAraliklari;
-        auto string_baslangic = std::sregex_iterator(metin.begin(), metin.end(), metinRegex);
-        auto string_bitis = std::sregex_iterator();
-
-        for (std::sregex_iterator i = string_baslangic; i != string_bitis; ++i) {
-            std::smatch eslesme = *i;
-            stringAraliklari.push_back({eslesme.position(), eslesme.position() + eslesme.length()});
-            Token token;
-            token.baslangic = eslesme.position();
-            token.bitis = token.baslangic + eslesme.length();
-            token.tip = METIN;
-            tokenlar.push_back(token);
-        }
-        // Karakterleri bul ve işaretle
-        std::vector<std::pair<int, int>> karakterAraliklari;
-        auto karakter_baslangic = std::sregex_iterator(metin.begin(), metin.end(), karakterRegex);
-        auto karakter_bitis = std::sregex_iterator();
-        for (std::sregex_iterator i = karakter_baslangic; i != karakter_bitis; ++i) {
-            std::smatch eslesme = *i;
-            karakterAraliklari.push_back({eslesme.position(), eslesme.position() + eslesme.length()});
-            Token token;
-            token.baslangic = eslesme.position();
-            token.bitis = token.baslangic + eslesme.length();
-            token.tip = KARAKTER;
-            tokenlar.push_back(token);
-        }
-        // Sonra yorumları bul ve işaretle
-        std::vector<std::pair<int, int>> yorumAraliklari;
-        auto yorum_baslangic = std::sregex_iterator(metin.begin(), metin.end(), yorumRegex);
-        auto yorum_bitis = std::sregex_iterator();
-        for (std::sregex_iterator i = yorum_baslangic; i != yorum_bitis; ++i) {
-            std::smatch eslesme = *i;
-            yorumAraliklari.push_back({eslesme.position(), eslesme.position() + eslesme.length()});
-            Token token;
-            token.baslangic = eslesme.position();
-            token.bitis = token.baslangic + eslesme.length();
-            token.tip = YORUM;
-            tokenlar.push_back(token);
-        }
-        // Diğer token'ları bul, ama string, karakter ve yorum içindeki kısımları atla
-        auto eslesmeKontrol = [&stringAraliklari, &karakterAraliklari, &yorumAraliklari]
-                             (int baslangic, int bitis) -> bool {
-            // String içinde mi kontrol et
-            for (const auto& str : stringAraliklari) {
-                if (baslangic >= str.first && bitis <= str.second) {
-                    return true;
-            }
+    Fl_Tree *agac;                    // Token'ları gösteren ağaç yapısı
+    Fl_Tree_Item *kaynakOgesi;        // Blok gruplarını tutan "Kaynak Kod" öğesi (nullptr: yok)
+    Fl_Tree_Item *seciliOge;          // İmleç için seçilen token öğesi (nullptr: yok)
+    TokenAkisi *akis;                 // Belgenin paylaşılan token akışı
+    bool agacVar;                     // Ağaç en az bir kez oluşturuldu mu
+    unsigned long agacRevizyonu;      // Ağacın oluşturulduğu belge revizyonu
+    int imlec;                        // İzlenen imleç konumu (-1: henüz yok)
+
+    // [ilkSatir, sonSatir) satırlarında başlayan token'ların indeks aralığı
+    std::pair<size_t, size_t> tokenAraligi(size_t ilkSatir, size_t sonSatir) const {
+        return {akis->satirTokenlari(ilkSatir).first, akis->satirTokenlari(sonSatir).first};
+    }
+
+    // Öğeyi kapalı bir grup olarak hazırlar
+    // Alt öğeler grup açılana kadar oluşturulmaz; açma simgesinin görünmesi için
+    // yerine tek bir yer tutucu eklenir
+    void grupHazirla(Fl_Tree_Item *oge, size_t satir, GrupTuru tur) {
+        oge->user_data(reinterpret_cast<void *>((uintptr_t)((satir << 1) | tur) + 1));
+        agac->add(oge, "...");
+        oge->close();
+    }
+
+    // Öğenin alt öğelerini siler; seçili token aralarındaysa unutulur
+    void altOgeleriSil(Fl_Tree_Item *oge) {
+        for (Fl_Tree_Item *o = seciliOge ? seciliOge->parent() : nullptr; o; o = o->parent()) {
+            if (o == oge) {
+                seciliOge = nullptr;
+                break;
             }
-            // Karakter içinde mi kontrol et
-            for (const auto& kar : karakterAraliklari) {
-                if (baslangic >= kar.first && bitis <= kar.second) {
-                    return true;
         }
+        agac->clear_children(oge);
     }
-            // Yorum içinde mi kontrol et
-            for (const auto& yorum : yorumAraliklari) {
-                if (baslangic >= yorum.first && bitis <= yorum.second) {
-                    return true;
-                }
-            }
-            return false;
-        };
-        // Anahtar kelimeleri bul
-        auto kelime_baslangic = std::sregex_iterator(metin.begin(), metin.end(), anahtarKelimeRegex);
-        auto kelime_bitis = std::sregex_iterator();
-        for (std::sregex_iterator i = kelime_baslangic; i != kelime_bitis; ++i) {
-            std::smatch eslesme = *i;
-            if (!eslesmeKontrol(eslesme.position(), eslesme.position() + eslesme.length())) {
-                Token token;
-                token.baslangic = eslesme.position();
-                token.bitis = token.baslangic + eslesme.length();
-                token.tip = ANAHTAR_KELIME;
-                tokenlar.push_back(token);
+
+    // Açılan grubun alt öğelerini oluşturur
+    void grubuDoldur(Fl_Tree_Item *oge) {
+        uintptr_t kod = reinterpret_cast<uintptr_t>(oge->user_data());
+        if (kod == 0) return;
+        size_t satir = (kod - 1) >> 1;
+        GrupTuru tur = (GrupTuru)((kod - 1) & 1);
+        const TokenDeposu &tokenlar = akis->getTokenlar();
+        const size_t satirSayisi = akis->getSatirlar().size();
+        altOgeleriSil(oge);
+        char etiket[64];
+        if (tur == GRUP_BLOK) {
+            // Bloğun token içeren satırları
+            size_t son = std::min(satir + BLOK_SATIR, satirSayisi);
+            for (size_t s = satir; s < son; ++s) {
+                std::pair<size_t, size_t> aralik = akis->satirTokenlari(s);
+                if (aralik.first == aralik.second) continue;
+                snprintf(etiket, sizeof(etiket), "Satır %zu (%zu token)", s + 1, aralik.second - aralik.first);
+                grupHazirla(agac->add(oge, etiket), s, GRUP_SATIR);
             }
-        }
-        // Sayıları bul
-        auto sayi_baslangic = std::sregex_iterator(metin.begin(), metin.end(), sayiRegex);
-        auto sayi_bitis = std::sregex_iterator();
-        for (std::sregex_iterator i = sayi_baslangic; i != sayi_bitis; ++i) {
-            std::smatch eslesme = *i;
-            if (!eslesmeKontrol(eslesme.position(), eslesme.position() + eslesme.length())) {
-                Token token;
-                token.baslangic = eslesme.position();
-                token.bitis = token.baslangic + eslesme.length();
-                token.tip = SAYI;
-                tokenlar.push_back(token);
+        } else {
+            // Satırın token'ları; etiketler yalnızca burada oluşturulur
+            std::pair<size_t, size_t> aralik = akis->satirTokenlari(satir);
+            std::string tokenEtiketi;
+            for (size_t i = aralik.first; i < aralik.second; ++i) {
+                const Token token = tokenlar[i];
+                tokenEtiketi = getTokenTipiAdi(token.tip);
+                tokenEtiketi += ": ";
+                tokenEtiketi += akis->tokenMetni(token);
+                Fl_Tree_Item *tokenOgesi = agac->add(oge, tokenEtiketi.c_str());
+                tokenOgesi->select(0);  // Seçimi devre dışı bırak
             }
         }
-        // Operatörleri bul
-        auto operator_baslangic = std::sregex_iterator(metin.begin(), metin.end(), operatorRegex);
-        auto operator_bitis = std::sregex_iterator();
-        for (std::sregex_iterator i = operator_baslangic; i != operator_bitis; ++i) {
-            std::smatch eslesme = *i;
-            if (!eslesmeKontrol(eslesme.position(), eslesme.position() + eslesme.length())) {
-                Token token;
-                token.baslangic = eslesme.position();
-                token.bitis = token.baslangic + eslesme.length();
-                token.tip = OPERATOR;
-                tokenlar.push_back(token);
-            }
+    }
+
+    // Grup öğesinin user_data'sındaki satır
+    static size_t grupSatiri(Fl_Tree_Item *oge) {
+        return (reinterpret_cast<uintptr_t>(oge->user_data()) - 1) >> 1;
+    }
+
+    // Alt grupları arasında 'satir'ı içeren (satırı 'satir'dan büyük olmayan son) grup
+    // Gruplar satır sırasıyla eklendiği için ikili aramadır
+    static Fl_Tree_Item *grupBul(Fl_Tree_Item *ust, size_t satir) {
+        int bas = 0, son = ust->children();
+        while (bas < son) {
+            int orta = bas + (son - bas) / 2;
+            if (ust->child(orta)->user_data() && grupSatiri(ust->child(orta)) <= satir) bas = orta + 1;
+            else son = orta;
         }
-        // Tanımlayıcıları bul
-        auto tanimlayici_baslangic = std::sregex_iterator(metin.begin(), metin.end(), tanimlayiciRegex);
-        auto tanimlayici_bitis = std::sregex_iterator();
-        for (std::sregex_iterator i = tanimlayici_baslangic; i != tanimlayici_bitis; ++i) {
-            std::smatch eslesme = *i;
-            if (!eslesmeKontrol(eslesme.position(), eslesme.position() + eslesme.length())) {
-                bool anahtarKelimeMi = std::regex_match(eslesme.str(), anahtarKelimeRegex);
-                if (!anahtarKelimeMi) {
-                    Token token;
-                    token.baslangic = eslesme.position();
-                    token.bitis = token.baslangic + eslesme.length();
-                    token.tip = TANIMLAYICI;
-                    tokenlar.push_back(token);
-                }
-            }
+        return bas > 0 ? ust->child(bas - 1) : nullptr;
+    }
+
+    // Kapalı grubu doldurup açar (callback çağrılmaz)
+    void grubuAc(Fl_Tree_Item *oge) {
+        if (oge->is_close()) {
+            grubuDoldur(oge);
+            agac->open(oge, 0);
         }
-        // Token'ları başlangıç pozisyonuna göre sırala
-        std::sort(tokenlar.begin(), tokenlar.end(),
-                 [](const Token &a, const Token &b) { return a.baslangic < b.baslangic; });
-    }
-    // Bulunan token'lara göre metni renklendirir
-    void vurgula() {
-        if (metinBuffer->length() == 0) return;
-        // Önce tüm metni tanımlayıcı rengiyle doldur
-        std::string stil(metinBuffer->length(), 'A' + TANIMLAYICI);
-        stilBuffer->text(stil.c_str());
-        // Her token için uygun rengi uygula
-        for (const Token &token : tokenlar) {
-            if (token.tip == BOSLUK) continue;  // Boşlukları atla
-            char stilKarakteri = 'A' + token.tip;
-            for (int i = token.baslangic; i < token.bitis; ++i) {
-                stilBuffer->replace(i, i + 1, &stilKarakteri, 1);
-            }
+    }
+
+    // İmlecin üzerindeki token'ı seçer; gerekirse bloğunu ve satırını açar
+    // Token ve satırı akışta ikili aramayla, gruplar ağaçta ikili aramayla bulunur
+    void imleciSec() {
+        if (imlec < 0 || !agacVar || agacRevizyonu != akis->revizyon() || !kaynakOgesi) return;
+        const TokenDeposu &tokenlar = akis->getTokenlar();
+        size_t i = tokenlar.konumdakiToken(imlec);
+        if (i == tokenlar.size()) return;
+        size_t satir = akis->satirNo(tokenlar.baslangic(i));
+        Fl_Tree_Item *blok = grupBul(kaynakOgesi, satir);
+        if (!blok) return;
+        grubuAc(blok);
+        Fl_Tree_Item *satirOgesi = grupBul(blok, satir);
+        if (!satirOgesi || grupSatiri(satirOgesi) != satir) return;
+        grubuAc(satirOgesi);
+        size_t sira = i - akis->satirTokenlari(satir).first;
+        if (sira >= (size_t)satirOgesi->children()) return;
+        Fl_Tree_Item *tokenOgesi = satirOgesi->child((int)sira);
+        // Ağaç taranmaz; yalnızca önceki seçim kaldırılır
+        if (seciliOge != tokenOgesi) {
+            if (seciliOge) agac->deselect(seciliOge, 0);
+            agac->select(tokenOgesi, 0);
+            seciliOge = tokenOgesi;
         }
+        agac->show_item_middle(tokenOgesi);
+        agac->redraw();
     }
-    // Stil buffer'ını dışarıya aç
-    Fl_Text_Buffer *getStilBuffer() { return stilBuffer; }
-    // Token listesini dışarıya aç
-    const std::vector<Token>& getTokenlar() const { return tokenlar; }
-};
 
-// Lexical analiz gösteren pencere sınıfı
-class LexicalAnalizPencere : public Fl_Window {
-private:
-    Fl_Tree *agac;                    // Token'ları gösteren ağaç yapısı
-    Fl_Text_Buffer *metinBuffer;      // Kaynak metin buffer'ı
-    SyntaxVurgulayici *vurgulayici;   // Syntax vurgulayıcı referansı
+    // Düzenlemeler durulunca ağacı yenileyip imleci yeniden seçer
+    static void yenile_cb(void *v) {
+        LexicalAnalizPencere *pencere = static_cast<LexicalAnalizPencere *>(v);
+        if (!pencere->visible()) return;
+        pencere->agaciGuncelle();
+        pencere->imleciSec();
+    }
+
+    // Grup açılınca doldurur, kapanınca alt öğelerini bırakır
+    static void agac_cb(Fl_Widget *, void *v) {
+        LexicalAnalizPencere *pencere = static_cast<LexicalAnalizPencere *>(v);
+        Fl_Tree_Item *oge = pencere->agac->callback_item();
+        if (!oge || !oge->user_data()) return;
+        if (pencere->agac->callback_reason() == FL_TREE_REASON_OPENED) {
+            pencere->grubuDoldur(oge);
+        } else if (pencere->agac->callback_reason() == FL_TREE_REASON_CLOSED) {
+            pencere->altOgeleriSil(oge);
+            pencere->agac->add(oge, "...");
+        }
+    }
 
 public:
     // Constructor: Pencereyi ve ağaç yapısını hazırlar
-    LexicalAnalizPencere(int genislik, int yukseklik, const char* baslik, Fl_Text_Buffer *buf, SyntaxVurgulayici *vrg)
-        : Fl_Window(genislik, yukseklik, baslik), metinBuffer(buf), vurgulayici(vrg) {
+    LexicalAnalizPencere(int genislik, int yukseklik, const char* baslik, TokenAkisi *tokenAkisi)
+        : Fl_Window(genislik, yukseklik, baslik), kaynakOgesi(nullptr), seciliOge(nullptr), akis(tokenAkisi),
+          agacVar(false), agacRevizyonu(0), imlec(-1) {
         agac = new Fl_Tree(10, 10, genislik-20, yukseklik-20);
         agac->showroot(0);                    // Kök düğümü gizle
         agac->connectorstyle(FL_TREE_CONNECTOR_DOTTED);  // Noktalı bağlantı çizgileri
         agac->selectmode(FL_TREE_SELECT_NONE);  // Seçimi devre dışı bırak
+        agac->callback(agac_cb, this);          // Gruplar açıldıkça doldurulur
+        agac->when(FL_WHEN_CHANGED);
         end();
     }
 
     // Ağacı güncel token'larla yeniler
+    // Yalnızca satır blokları eklenir; satırlar ve token'lar açıldıkça oluşturulur.
+    // Belge son oluşturmadan beri değişmediyse hiçbir şey yapmaz
     void agaciGuncelle() {
+        if (agacVar && agacRevizyonu == akis->revizyon()) return;
+        OlcumKapsami olcum(OA_LEX_AGACI);
+        agacVar = true;
+        agacRevizyonu = akis->revizyon();
+        // Ağaç bütün satırları gösterir; henüz lexlenmemiş kısım varsa önce o lexlenir
+        akis->tamamla();
         agac->clear();
-        std::string metin = metinBuffer->text();
-        if (metin.empty()) return;
-        // Kök düğümü ekle
+        kaynakOgesi = nullptr;
+        seciliOge = nullptr;
+        if (akis->getTokenlar().empty()) return;
+        // Kök düğümü ekle; gizli kökün tek alt öğesidir, bloklar bunun altındadır
         Fl_Tree_Item *kok = agac->add("Kaynak Kod");
         kok->open();  // Kök düğümü açık başlat
-        // Her token'ı ağaca ekle
-        for (const Token &token : vurgulayici->getTokenlar()) {
-            std::string tokenMetni = metin.substr(token.baslangic, token.bitis - token.baslangic);
-            std::stringstream ss;
-            ss << getTokenTipiAdi(token.tip) << ": " << tokenMetni;
-            Fl_Tree_Item *oge = agac->add(kok, ss.str().c_str());
-            oge->select(0);  // Seçimi devre dışı bırak
+        kaynakOgesi = kok;
+        olcum.say(OS_OGE, 1);
+        // Token içeren her satır bloğu için bir grup ekle
+        const size_t satirSayisi = akis->getSatirlar().size();
+        char etiket[64];
+        for (size_t bas = 0; bas < satirSayisi; bas += BLOK_SATIR) {
+            size_t son = std::min(bas + BLOK_SATIR, satirSayisi);
+            std::pair<size_t, size_t> aralik = tokenAraligi(bas, son);
+            if (aralik.first == aralik.second) continue;
+            snprintf(etiket, sizeof(etiket), "Satır %zu-%zu (%zu token)", bas + 1, son, aralik.second - aralik.first);
+            grupHazirla(agac->add(kok, etiket), bas, GRUP_BLOK);
+            olcum.say(OS_OGE, 2);  // Grup ve yer tutucusu
         }
+        olcum.say(OS_TOKEN, akis->getTokenlar().size());
+    }
+
+    // Düzenleyicideki imleci izler; pencere açıkken imlecin üzerindeki token seçilir
+    // Belge ağaç oluşturulduktan sonra değiştiyse ağaç, düzenlemeler durulunca yenilenir
+    void imleciGoster(int konum) {
+        imlec = konum;
+        if (!visible()) return;
+        Fl::remove_timeout(yenile_cb, this);
+        if (agacRevizyonu != akis->revizyon()) {
+            Fl::add_timeout(0.25, yenile_cb, this);
+            return;
+        }
+        imleciSec();
+    }
+
+    // Pencereyi gösterir; imleç biliniyorsa token'ı seçilir
+    void goster() {
+        agaciGuncelle();
+        show();
+        imleciSec();
     }
 
     // Token tipini Türkçe isme çevirir
@@ -284,6 +250,7 @@ public:
             case KARAKTER: return "Karakter";
             case YORUM: return "Yorum";
             case BOSLUK: return "Bosluk";
+            case NOKTALAMA: return "Noktalama";
             default: return "Bilinmeyen";
         }
     }
@@ -292,24 +259,254 @@ public:
 // Lexical analiz penceresini gösteren callback
 void lex_goster_cb(Fl_Widget*, void* v) {
     LexicalAnalizPencere *lexPencere = static_cast<LexicalAnalizPencere*>(v);
-    lexPencere->agaciGuncelle();
-    lexPencere->show();
+    lexPencere->goster();
+}
+
+// İmleç her yer değiştirdiğinde açık pencerelerde imlecin altındaki token'ı ve düğümü seçen düzenleyici
+// FLTK imleç hareketi için callback sunmadığından konum her olaydan sonra karşılaştırılır
+class ImlecIzleyenDuzenleyici : public Fl_Text_Editor {
+private:
+    int sonKonum;
+    TokenAkisi *akis;
+    LexicalAnalizPencere *lexPencere;
+    ParseTreeWindow *parsePencere;
+
+    // İmleç bir sözcüğün hemen ardındaysa (üzerinde boşluk varsa) o sözcük kullanılır
+    int izlenecekKonum(int konum) const {
+        const TokenDeposu &tokenlar = akis->getTokenlar();
+        size_t i = tokenlar.konumdakiToken(konum);
+        if (konum > 0 && (i == tokenlar.size() || tokenlar.tip(i) == BOSLUK)) {
+            size_t onceki = tokenlar.konumdakiToken(konum - 1);
+            if (onceki != tokenlar.size() && tokenlar.tip(onceki) != BOSLUK) return konum - 1;
+        }
+        return konum;
+    }
+
+public:
+    ImlecIzleyenDuzenleyici(int x, int y, int w, int h)
+        : Fl_Text_Editor(x, y, w, h), sonKonum(-1), akis(nullptr), lexPencere(nullptr), parsePencere(nullptr) {}
+
+    void izle(TokenAkisi *tokenAkisi, LexicalAnalizPencere *lex, ParseTreeWindow *parse) {
+        akis = tokenAkisi;
+        lexPencere = lex;
+        parsePencere = parse;
+    }
+
+    // İmleç değiştiyse pencerelere bildirir
+    void imleciBildir() {
+        if (akis && insert_position() != sonKonum) {
+            sonKonum = insert_position();
+            int konum = izlenecekKonum(sonKonum);
+            lexPencere->imleciGoster(konum);
+            parsePencere->showCursor((uint32_t)konum);
+        }
+    }
+
+    // F12 imlecin altındaki adın tanımına, Shift+F12 sonraki kullanımına gider
+    int handle(int olay) override {
+        if (akis && olay == FL_KEYBOARD && Fl::event_key() == FL_F + 12) {
+            bool tanim = !(Fl::event_state() & FL_SHIFT);
+            parsePencere->jumpToSymbol((uint32_t)izlenecekKonum(insert_position()), tanim);
+            return 1;
+        }
+        int sonuc = Fl_Text_Editor::handle(olay);
+        imleciBildir();
+        return sonuc;
+    }
+
+    // Ada gitme sonucu; gidiş ayrıştırma bitince olay dışında gelebilir
+    static void git_cb(uint32_t konum, void *v) {
+        ImlecIzleyenDuzenleyici *duzenleyici = static_cast<ImlecIzleyenDuzenleyici *>(v);
+        duzenleyici->insert_position((int)konum);
+        duzenleyici->show_insert_position();
+        duzenleyici->imleciBildir();
+    }
+};
+
+// Aşama ölçümlerini gösteren isteğe bağlı durum çubuğu
+// Ölçüm düğmesiyle açılır; açıkken her aşamanın son süresini, en uzun
+// süresini ve son sayaçlarını yarım saniyede bir yeniler
+class OlcumCubugu {
+private:
+    static const int YUKSEKLIK = 25;
+    Fl_Window *pencere;   // Çubuk açılınca pencere bu kadar uzar
+    Fl_Box *kutu;
+    std::string metin;    // Kutunun etiketi (kutu metni kopyalamaz)
+
+    static void yenile_cb(void *v) {
+        OlcumCubugu *cubuk = static_cast<OlcumCubugu *>(v);
+        cubuk->yenile();
+        Fl::repeat_timeout(0.5, yenile_cb, v);
+    }
+
+    void yenile() {
+        static const char *birimler[OS_SAYISI] = {"bayt", "token", "düğüm", "öğe"};
+        char parca[160];
+        metin.clear();
+        for (int a = 0; a < OA_SAYISI; ++a) {
+            AsamaIstatistigi ist = asamaIstatistigi((OlcumAsamasi)a);
+            if (ist.cagri == 0) continue;
+            if (!metin.empty()) metin += "  |  ";
+            snprintf(parca, sizeof(parca), "%s %.2f ms (en uzun %.2f)", asamaAdi((OlcumAsamasi)a),
+                     ist.sonSure * 1000, ist.enUzunSure * 1000);
+            metin += parca;
+            for (int s = 0; s < OS_SAYISI; ++s) {
+                if (!ist.sonSayac[s]) continue;
+                snprintf(parca, sizeof(parca), " %llu %s", (unsigned long long)ist.sonSayac[s], birimler[s]);
+                metin += parca;
+            }
+        }
+        if (metin.empty()) metin = "Ölçüm açık; henüz ölçülen aşama yok";
+        kutu->label(metin.c_str());
+        kutu->redraw();
+    }
+
+public:
+    OlcumCubugu(Fl_Window *p, Fl_Box *k) : pencere(p), kutu(k) {}
+
+    void ac(bool acik) {
+        if (acik == olcumEtkin()) return;
+        olcumEtkinlestir(acik);
+        if (acik) {
+            pencere->size(pencere->w(), pencere->h() + YUKSEKLIK);
+            kutu->show();
+            yenile();
+            Fl::add_timeout(0.5, yenile_cb, this);
+        } else {
+            Fl::remove_timeout(yenile_cb, this);
+            kutu->hide();
+            pencere->size(pencere->w(), pencere->h() - YUKSEKLIK);
+        }
+    }
+};
+
+// Ölçüm düğmesine basıldığında çağrılan callback
+void olcum_cb(Fl_Widget *w, void *v) {
+    static_cast<OlcumCubugu *>(v)->ac(static_cast<Fl_Toggle_Button *>(w)->value() != 0);
 }
 
-// Metin değiştiğinde çağrılan callback
-void metin_degisti_cb(int pos, int nInserted, int nDeleted, int, const char *, void *v) {
-    if (nInserted || nDeleted) {
-        SyntaxVurgulayici *vurgulayici = static_cast<SyntaxVurgulayici *>(v);
-        vurgulayici->tokenize();
-        vurgulayici->vurgula();
+// Ölçülen aşamaları Chrome iz dosyası olarak kaydeden callback
+void iz_kaydet_cb(Fl_Widget *, void *) {
+    Fl_Native_File_Chooser secici;
+    secici.title("İz Dosyasını Kaydet");
+    secici.type(Fl_Native_File_Chooser::BROWSE_SAVE_FILE);
+    secici.filter("Chrome izi\t*.json");
+    secici.preset_file("syntax_iz.json");
+    secici.options(Fl_Native_File_Chooser::SAVEAS_CONFIRM);
+    if (secici.show() != 0) return;
+    long olaySayisi = olcumIziniYaz(secici.filename());
+    if (olaySayisi < 0) {
+        fl_alert("%s yazılamadı", secici.filename());
+    } else if (olaySayisi == 0) {
+        fl_message("Kaydedilecek ölçüm yok; önce Ölçüm düğmesiyle ölçümü açın");
     }
 }
 
-int main() {
+// Düzenlemeleri gecikme_bench ile yeniden oynatılmak üzere kaydeder
+struct DuzenlemeKaydi {
+    FILE *dosya;
+    Fl_Text_Buffer *buffer;
+};
+
+void duzenleme_kaydet_cb(int pos, int nInserted, int nDeleted, int, const char *deletedText, void *v) {
+    if (!nInserted && !nDeleted) return;
+    DuzenlemeKaydi *kayit = static_cast<DuzenlemeKaydi *>(v);
+    Duzenleme duzenleme;
+    duzenleme.konum = pos;
+    duzenleme.silinen = nDeleted;
+    if (nInserted) {
+        char *eklenen = kayit->buffer->text_range(pos, pos + nInserted);
+        duzenleme.eklenen.assign(eklenen, nInserted);
+        free(eklenen);
+    }
+    duzenleme.tur = duzenlemeTuru(deletedText, nDeleted, duzenleme.eklenen);
+    duzenlemeYaz(kayit->dosya, duzenleme);
+}
+
+// Komut satırından açılan dosyanın önbellek girdisi
+// Girdi bulunursa token'lar, satır kayıtları ve varsa ağaç lexleme ve
+// ayrıştırma yapılmadan yüklenir. Bulunmazsa token'lar açılış metninin
+// lexlenmesi (boşta) bitince, ağaç ise sözdizimi ağacı penceresi açılış
+// revizyonunu ilk kez ayrıştırdığında yazılır.
+struct AcilisOnbellegi {
+    std::string dizin;       // Önbellek dizini (boş: kapalı)
+    uint64_t ozet;           // Açılan metnin içerik özeti
+    size_t uzunluk;
+    unsigned long revizyon;  // Açılıştaki belge revizyonu
+    bool agacVar;            // Girdide ağaç var mı
+    TokenAkisi *akis;
+};
+
+// Açılış revizyonunun token'larını, satır kayıtlarını ve (varsa) ağacı önbelleğe yazar
+void onbellegeKaydet(const AcilisOnbellegi &o, const ParseTreeImage *agac) {
+    // Dosyadaki token'lar Token dizisi olarak saklanır; sıkı liste açılır
+    std::vector<Token> tokenlar;
+    o.akis->getTokenlar().kopyala(tokenlar);
+    OnbellekIcerigi icerik;
+    icerik.ozet = o.ozet;
+    icerik.metinUzunlugu = o.uzunluk;
+    icerik.tokenlar = tokenlar.data();
+    icerik.tokenSayisi = tokenlar.size();
+    icerik.satirlar = o.akis->getSatirlar().data();
+    icerik.satirSayisi = o.akis->getSatirlar().size();
+    icerik.agac = agac;
+    if (!onbellegeYaz(o.dizin, icerik)) fprintf(stderr, "Önbelleğe yazılamadı: %s\n", o.dizin.c_str());
+}
+
+// Açılış revizyonunun ağacı ilk kez görüntülendiğinde girdiyi ağaçla tamamlar
+void agac_hazir_cb(const ParseTree &agac, unsigned long revizyon, void *v) {
+    AcilisOnbellegi *o = static_cast<AcilisOnbellegi *>(v);
+    if (o->agacVar || revizyon != o->revizyon || o->akis->revizyon() != o->revizyon) return;
+    o->agacVar = true;
+    ParseTreeImage goruntu = agac.image();
+    onbellegeKaydet(*o, &goruntu);
+}
+
+// Açılış metninin lexlenmesi bittiğinde token'ları önbelleğe yazar
+// Bu arada metin düzenlendiyse veya ağaç (token'larla birlikte) yazıldıysa yazmaz
+void lexleme_bitti_cb(void *v) {
+    AcilisOnbellegi *o = static_cast<AcilisOnbellegi *>(v);
+    if (o->agacVar || o->akis->revizyon() != o->revizyon) return;
+    onbellegeKaydet(*o, nullptr);
+}
+
+// Açılan metnin token'larını önbellekten yükler; bulamazsa metnin başını lexler,
+// gerisi lexlenince önbelleğe yazar
+void acilistaTokenize(AcilisOnbellegi &o, SyntaxVurgulayici &vurgulayici, ParseTreeWindow *parsePencere) {
+    OnbellekGirdisi girdi;
+    bool bulundu = !o.dizin.empty() && girdi.ac(o.dizin, o.ozet, o.uzunluk);
+    // syntax_cli'nin yazdığı girdilerde satır kayıtları yoktur; token'lar
+    // yeniden bulunur ama girdideki ağaç kullanılır
+    bool satirlarVar = bulundu && girdi.satirlarVar();
+    if (satirlarVar) {
+        OlcumKapsami olcum(OA_TOKENIZE);
+        o.akis->yukle(girdi.tokenlar(), girdi.tokenSayisi(), girdi.satirlar(), girdi.satirSayisi());
+        olcum.say(OS_TOKEN, girdi.tokenSayisi());
+    } else {
+        vurgulayici.tokenize();
+    }
+    o.revizyon = o.akis->revizyon();
+    o.agacVar = bulundu && girdi.agacVar();
+    ParseTreeImage agac;
+    if (o.agacVar) {
+        agac = girdi.agac();
+        parsePencere->seedTree(agac);
+    }
+    if (o.dizin.empty()) return;
+    if (!satirlarVar) {
+        // Ağaç yüklendiyse akış onunla birlikte tamamlanmıştır
+        if (o.akis->tamamlandi()) onbellegeKaydet(o, o.agacVar ? &agac : nullptr);
+        else vurgulayici.setTamamlandiCb(lexleme_bitti_cb, &o);
+    }
+    if (!o.agacVar) parsePencere->setTreeListener(agac_hazir_cb, &o);
+}
+
+int main(int argc, char **argv) {
+    olcumIsParcacigiAdi("arayuz");
     // Ana pencereyi oluştur
     Fl_Window *pencere = new Fl_Window(800, 600, "C++ Syntax Vurgulayici");
     // Metin düzenleyiciyi oluştur
-    Fl_Text_Editor *duzenleyici = new Fl_Text_Editor(20, 20, 760, 520);
+    ImlecIzleyenDuzenleyici *duzenleyici = new ImlecIzleyenDuzenleyici(20, 20, 760, 520);
     Fl_Text_Buffer *metinBuffer = new Fl_Text_Buffer();
     duzenleyici->buffer(metinBuffer);
     
@@ -317,19 +514,35 @@ int main() {
     Fl_Button *lexButon = new Fl_Button(20, 550, 120, 30, "Lexical Analiz");
     // Parse Tree butonunu oluştur
     Fl_Button *parseButon = new Fl_Button(150, 550, 120, 30, "Sözdizimi Ağacı");
+    // Ölçüm düğmeleri ve pencerenin altındaki durum çubuğu (kapalı başlar)
+    Fl_Toggle_Button *olcumButon = new Fl_Toggle_Button(280, 550, 100, 30, "Ölçüm");
+    Fl_Button *izButon = new Fl_Button(390, 550, 100, 30, "İz Kaydet");
+    Fl_Box *durumCubugu = new Fl_Box(0, 600, 800, 25);
+    durumCubugu->box(FL_THIN_DOWN_BOX);
+    durumCubugu->align(FL_ALIGN_LEFT | FL_ALIGN_INSIDE | FL_ALIGN_CLIP);
+    durumCubugu->labelsize(12);
+    durumCubugu->hide();
+    OlcumCubugu olcumCubugu(pencere, durumCubugu);
     
+    // Belgenin tek token akışını oluştur
+    Belge belge;
+    TokenAkisi akis(belge);
     // Syntax vurgulayıcıyı oluştur
-    SyntaxVurgulayici vurgulayici(metinBuffer);
+    SyntaxVurgulayici vurgulayici(metinBuffer, &akis);
     
     // Lexical Analiz penceresini oluştur
-    LexicalAnalizPencere *lexPencere = new LexicalAnalizPencere(400, 600, "Lexical Analiz", metinBuffer, &vurgulayici);
+    LexicalAnalizPencere *lexPencere = new LexicalAnalizPencere(400, 600, "Lexical Analiz", &akis);
     // Parse Tree penceresini oluştur
-    ParseTreeWindow *parsePencere = new ParseTreeWindow(400, 600, "Sözdizimi Ağacı", metinBuffer);
+    ParseTreeWindow *parsePencere = new ParseTreeWindow(400, 600, "Sözdizimi Ağacı", &akis);
     
+    // İmleç hareketleri iki pencereye de iletilir
+    duzenleyici->izle(&akis, lexPencere, parsePencere);
+    parsePencere->setJumpListener(ImlecIzleyenDuzenleyici::git_cb, duzenleyici);
     // Callback'leri ayarla
     lexButon->callback(lex_goster_cb, lexPencere);
     parseButon->callback(parse_tree_cb, parsePencere);
-    metinBuffer->add_modify_callback(metin_degisti_cb, &vurgulayici);
+    olcumButon->callback(olcum_cb, &olcumCubugu);
+    izButon->callback(iz_kaydet_cb);
     // Stil tablosunu tanımla
     Fl_Text_Display::Style_Table_Entry stilTablosu[] = {
         { FL_RED,        FL_COURIER_BOLD, 14 },    // A - ANAHTAR_KELIME
@@ -339,44 +552,94 @@ int main() {
         { FL_MAGENTA,    FL_COURIER, 14 },         // E - METIN
         { FL_DARKGOLD,  FL_COURIER, 14 },         // F - KARAKTER
         { FL_GRAY,       FL_COURIER_ITALIC, 14 },  // G - YORUM
-        { FL_WHITE,      FL_COURIER, 14 }         // H - BOSLUK
+        { FL_WHITE,      FL_COURIER, 14 },        // H - BOSLUK
+        { FL_BLACK,      FL_COURIER, 14 }         // I - NOKTALAMA
     };
     // Düzenleyiciye stil tablosunu uygula
-    duzenleyici->highlight_data(vurgulayici.getStilBuffer(), stilTablosu, sizeof(stilTablosu) / sizeof(stilTablosu[0]), 'A', 0, 0);
-    // Örnek kod
-    metinBuffer->text(
-        "// Bu bir yorum satırıdır\n"
-        "/* Bu da\n"
-        "   çok satırlı\n"
-        "   bir yorumdur */\n\n"
-        "string mesaj = \"Merhaba Dünya!\";\n"
-        "int sayi = 42;\n"
-        "float pi = 3.14159;\n"
-        "char karakter = 'A';\n\n"
-        "string hesapla(int x, float y) {\n"
-        "    if (x > 0 && y < 100.0) {\n"
-        "        string sonuc = \"Pozitif\";\n"
-        "        return sonuc;\n"
-        "    } else {\n"
-        "        while (x != 0) {\n"
-        "            x = x - 1;\n"
-        "            y = y * 2.0;\n"
-        "        }\n"
-        "        for (int i = 0; i < 10; i++) {\n"
-        "            float toplam = x + y;\n"
-        "            if (toplam >= 50.0) {\n"
-        "                break;\n"
-        "            }\n"
-        "        }\n"
-        "    }\n"
-        "    return \"Bitti\";\n"
-        "}\n\n"
-    );
+    vurgulayici.setGorunum(duzenleyici);
+    // Stili henüz hesaplanmamış karakterler çizilmeden önce vurgulayıcıya sorulur
+    duzenleyici->highlight_data(vurgulayici.getStilBuffer(), stilTablosu, sizeof(stilTablosu) / sizeof(stilTablosu[0]),
+                                SyntaxVurgulayici::STIL_BEKLIYOR, SyntaxVurgulayici::stil_bekliyor_cb, &vurgulayici);
+    // Komut satırında bir dosya verildiyse o, yoksa örnek kod açılır
+    // Metin, düzenleme callback'leri bağlanmadan yüklenir; ilk token'lar aşağıda bir kez bulunur
+    AcilisOnbellegi onbellek = {std::string(), 0, 0, 0, false, &akis};
+    if (argc > 1) {
+        EslenmisDosya dosya;
+        if (!dosya.ac(argv[1])) {
+            fprintf(stderr, "Dosya açılamadı: %s\n", argv[1]);
+            return 1;
+        }
+        std::string_view icerik = dosya.metin();
+        metinBuffer->text(std::string(icerik).c_str());
+        // İçinde NUL bulunan metin buffer'a kısaltılarak girer; önbellek yalnızca metnin tamamı yüklendiyse kullanılır
+        if ((size_t)metinBuffer->length() == icerik.size()) {
+            onbellek.dizin = varsayilanOnbellekDizini();
+            onbellek.ozet = icerikOzeti(icerik.data(), icerik.size());
+            onbellek.uzunluk = icerik.size();
+        }
+    } else {
+        metinBuffer->text(
+            "// Bu bir yorum satırıdır\n"
+            "/* Bu da\n"
+            "   çok satırlı\n"
+            "   bir yorumdur */\n\n"
+            "string mesaj = \"Merhaba Dünya!\";\n"
+            "int sayi = 42;\n"
+            "float pi = 3.14159;\n"
+            "char karakter = 'A';\n\n"
+            "string hesapla(int x, float y) {\n"
+            "    if (x > 0 && y < 100.0) {\n"
+            "        string sonuc = \"Pozitif\";\n"
+            "        return sonuc;\n"
+            "    } else {\n"
+            "        while (x != 0) {\n"
+            "            x = x - 1;\n"
+            "            y = y * 2.0;\n"
+            "        }\n"
+            "        for (int i = 0; i < 10; i++) {\n"
+            "            float toplam = x + y;\n"
+            "            if (toplam >= 50.0) {\n"
+            "                break;\n"
+            "            }\n"
+            "        }\n"
+            "    }\n"
+            "    return \"Bitti\";\n"
+            "}\n\n"
+        );
+    }
+    // Belge açılıştaki metinle bir kez doldurulur; sonraki düzenlemeler ona metin_degisti_cb ile uygulanır
+    {
+        char *metin = metinBuffer->text();
+        belge.yukle(metin, metinBuffer->length());
+        free(metin);
+    }
+    metinBuffer->add_modify_callback(metin_degisti_cb, &vurgulayici);
+    metinBuffer->add_modify_callback(metin_degisti_parse_cb, parsePencere);
+    // SYNTAX_KAYIT ortam değişkeni verilmişse başlangıç metni ve bütün düzenlemeler o dosyaya yazılır
+    DuzenlemeKaydi kayit = {nullptr, metinBuffer};
+    if (const char *kayitYolu = std::getenv("SYNTAX_KAYIT")) {
+        kayit.dosya = fopen(kayitYolu, "w");
+        if (kayit.dosya) {
+            char *baslangic = metinBuffer->text();
+            duzenlemeYaz(kayit.dosya, Duzenleme{"yukle", 0, 0, baslangic});
+            free(baslangic);
+            metinBuffer->add_modify_callback(duzenleme_kaydet_cb, &kayit);
+        }
+    }
     // Pencereyi göster ve uygulamayı başlat
     pencere->end();
     pencere->show();
-    // İlk token'ları bul ve vurgula
-    vurgulayici.tokenize();
+    // SYNTAX_OLCUM ortam değişkeni verilmişse açılıştaki lexleme de ölçülür
+    if (std::getenv("SYNTAX_OLCUM")) {
+        olcumButon->value(1);
+        olcumCubugu.ac(true);
+    }
+    // İlk token'ları önbellekten yükle veya ilk ekranları lexle, sonra vurgula
+    // Önbellekte yoksa metnin geri kalanı ilk çizimden sonra boşta tamamlanır
+    acilistaTokenize(onbellek, vurgulayici, parsePencere);
     vurgulayici.vurgula();
+    // Arka plan ayrıştırıcısının Fl::awake ile sonuç iletebilmesi için
+    // FLTK'nın çoklu iş parçacığı desteğini etkinleştir
+    Fl::lock();
     return Fl::run();
 }
@@ -0,0 +1,184 @@
+#include "olcum.h"
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace olcum_detay {
+std::atomic<bool> etkin(false);
+}
+
+namespace {
+
+using olcum_detay::Saat;
+
+// Saklanan en fazla iz olayı (~14 MB)
+const size_t HALKA_BOYUTU = 1u << 18;
+
+struct IzOlayi {
+    uint8_t asama;
+    uint32_t isParcacigi;
+    int64_t baslangic;   // Nano saniye (ölçümün başlangıcına göre)
+    int64_t sure;        // Nano saniye
+    uint64_t sayac[OS_SAYISI];
+};
+
+struct Kayitlar {
+    std::mutex kilit;
+    AsamaIstatistigi istatistik[OA_SAYISI];
+    std::vector<IzOlayi> halka;
+    size_t yazilan = 0;  // Halkaya şimdiye kadar yazılan olay sayısı
+    std::vector<std::pair<uint32_t, std::string>> isParcacigiAdlari;
+    Saat::time_point baslangic = Saat::now();  // İzlerdeki zamanların sıfır noktası
+};
+
+// Statik başlatma sırasından bağımsız olsun diye ilk kullanımda oluşturulur
+Kayitlar &kayitlar() {
+    static Kayitlar k;
+    return k;
+}
+
+uint32_t isParcacigiNo() {
+    static std::atomic<uint32_t> sonraki(1);
+    thread_local uint32_t no = sonraki.fetch_add(1);
+    return no;
+}
+
+int64_t nanoSaniye(Saat::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+void jsonMetni(FILE *f, const char *s) {
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') std::fprintf(f, "\\%c", c);
+        else if (c < 0x20) std::fprintf(f, "\\u%04x", c);
+        else std::fputc(c, f);
+    }
+    std::fputc('"', f);
+}
+
+} // namespace
+
+void olcum_detay::kaydet(OlcumAsamasi asama, Saat::time_point baslangic, Saat::time_point bitis,
+                         const uint64_t *sayac) {
+    Kayitlar &k = kayitlar();
+    double sure = std::chrono::duration<double>(bitis - baslangic).count();
+    uint32_t no = isParcacigiNo();
+    std::lock_guard<std::mutex> kilit(k.kilit);
+    AsamaIstatistigi &ist = k.istatistik[asama];
+    ++ist.cagri;
+    ist.toplamSure += sure;
+    ist.sonSure = sure;
+    if (sure > ist.enUzunSure) ist.enUzunSure = sure;
+    for (int i = 0; i < OS_SAYISI; ++i) {
+        ist.sayac[i] += sayac[i];
+        ist.sonSayac[i] = sayac[i];
+    }
+    if (k.halka.size() < HALKA_BOYUTU) k.halka.emplace_back();
+    IzOlayi &olay = k.halka[k.yazilan % HALKA_BOYUTU];
+    ++k.yazilan;
+    olay.asama = (uint8_t)asama;
+    olay.isParcacigi = no;
+    olay.baslangic = nanoSaniye(baslangic - k.baslangic);
+    olay.sure = nanoSaniye(bitis - baslangic);
+    for (int i = 0; i < OS_SAYISI; ++i) olay.sayac[i] = sayac[i];
+}
+
+void olcumEtkinlestir(bool ac) {
+    Kayitlar &k = kayitlar();
+    if (ac && !olcumEtkin()) {
+        std::lock_guard<std::mutex> kilit(k.kilit);
+        for (AsamaIstatistigi &ist : k.istatistik) ist = AsamaIstatistigi();
+        k.halka.clear();
+        k.yazilan = 0;
+        k.baslangic = Saat::now();
+    }
+    olcum_detay::etkin.store(ac, std::memory_order_relaxed);
+}
+
+AsamaIstatistigi asamaIstatistigi(OlcumAsamasi asama) {
+    Kayitlar &k = kayitlar();
+    std::lock_guard<std::mutex> kilit(k.kilit);
+    return k.istatistik[asama];
+}
+
+const char *asamaAdi(OlcumAsamasi asama) {
+    switch (asama) {
+        case OA_TOKENIZE: return "tokenize";
+        case OA_VURGULA: return "vurgula";
+        case OA_PARSE: return "parse";
+        case OA_LEX_AGACI: return "agaciGuncelle";
+        case OA_AGAC_ESITLE: return "agacEsitle";
+        case OA_AGAC_EKLE: return "agacaEkle";
+        default: return "bilinmeyen";
+    }
+}
+
+const char *sayacAdi(OlcumSayaci sayac) {
+    switch (sayac) {
+        case OS_BAYT: return "bytes";
+        case OS_TOKEN: return "tokens";
+        case OS_DUGUM: return "nodes";
+        case OS_OGE: return "items";
+        default: return "count";
+    }
+}
+
+void olcumIsParcacigiAdi(const char *ad) {
+    Kayitlar &k = kayitlar();
+    uint32_t no = isParcacigiNo();
+    std::lock_guard<std::mutex> kilit(k.kilit);
+    for (auto &kayit : k.isParcacigiAdlari) {
+        if (kayit.first == no) {
+            kayit.second = ad;
+            return;
+        }
+    }
+    k.isParcacigiAdlari.emplace_back(no, ad);
+}
+
+long olcumIziniYaz(const char *yol) {
+    // Olaylar kilit altında kopyalanır; dosya kilit dışında yazılır
+    std::vector<IzOlayi> olaylar;
+    std::vector<std::pair<uint32_t, std::string>> adlar;
+    {
+        Kayitlar &k = kayitlar();
+        std::lock_guard<std::mutex> kilit(k.kilit);
+        // En eskiden en yeniye sırala
+        size_t bas = k.yazilan > HALKA_BOYUTU ? k.yazilan % HALKA_BOYUTU : 0;
+        olaylar.reserve(k.halka.size());
+        for (size_t i = 0; i < k.halka.size(); ++i) olaylar.push_back(k.halka[(bas + i) % k.halka.size()]);
+        adlar = k.isParcacigiAdlari;
+    }
+    FILE *f = std::fopen(yol, "w");
+    if (!f) return -1;
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool ilk = true;
+    for (const auto &ad : adlar) {
+        std::fprintf(f, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                     ilk ? "" : ",", ad.first);
+        jsonMetni(f, ad.second.c_str());
+        std::fprintf(f, "}}");
+        ilk = false;
+    }
+    for (const IzOlayi &olay : olaylar) {
+        std::fprintf(f, "%s\n{\"name\":\"%s\",\"cat\":\"syntax\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+                     ilk ? "" : ",", asamaAdi((OlcumAsamasi)olay.asama), olay.isParcacigi,
+                     olay.baslangic / 1000.0, olay.sure / 1000.0);
+        bool ilkSayac = true;
+        for (int i = 0; i < OS_SAYISI; ++i) {
+            if (!olay.sayac[i]) continue;
+            std::fprintf(f, "%s\"%s\":%llu", ilkSayac ? "" : ",", sayacAdi((OlcumSayaci)i),
+                         (unsigned long long)olay.sayac[i]);
+            ilkSayac = false;
+        }
+        std::fprintf(f, "}}");
+        ilk = false;
+    }
+    std::fprintf(f, "\n]}\n");
+    bool hata = std::ferror(f) != 0;
+    if (std::fclose(f) != 0 || hata) return -1;
+    return (long)olaylar.size();
+}
@@ -0,0 +1,89 @@
+#ifndef OLCUM_H
+#define OLCUM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Sıcak yoldaki aşamaların süre ve sayaç ölçümleri
+// Her aşama bir OlcumKapsami ile sarılır. Ölçüm kapalıyken kapsam yalnızca
+// bir atomik bayrağı okur; saat okunmaz, kilit alınmaz. Açıkken her kapsamın
+// süresi ve sayaçları aşama istatistiklerine eklenir ve Chrome'un iz olayı
+// (trace event) biçiminde yazılabilmek üzere sınırlı bir halkada saklanır.
+enum OlcumAsamasi {
+    OA_TOKENIZE,      // Düzenlemeden sonra token'ların güncellenmesi
+    OA_VURGULA,       // Stil karakterlerinin hesaplanıp stil buffer'ına yazılması
+    OA_PARSE,         // Arka planda ayrıştırma (artımlı veya baştan)
+    OA_LEX_AGACI,     // Lexical analiz penceresinin ağacının yenilenmesi (agaciGuncelle)
+    OA_AGAC_ESITLE,   // Sözdizimi ağacı görünümünün yeni ağaca eşitlenmesi
+    OA_AGAC_EKLE,     // Sözdizimi ağacı görünümüne yeni öğelerin eklenmesi
+    OA_SAYISI
+};
+
+enum OlcumSayaci {
+    OS_BAYT,    // İşlenen metin (bayt)
+    OS_TOKEN,   // Üretilen token
+    OS_DUGUM,   // Oluşturulan düğüm
+    OS_OGE,     // Eklenen ağaç öğesi
+    OS_SAYISI
+};
+
+struct AsamaIstatistigi {
+    uint64_t cagri;               // Ölçülen kapsam sayısı
+    double toplamSure;            // Saniye
+    double sonSure;
+    double enUzunSure;
+    uint64_t sayac[OS_SAYISI];    // Bütün kapsamların toplamı
+    uint64_t sonSayac[OS_SAYISI]; // Son kapsamın sayaçları
+};
+
+namespace olcum_detay {
+extern std::atomic<bool> etkin;
+typedef std::chrono::steady_clock Saat;
+void kaydet(OlcumAsamasi asama, Saat::time_point baslangic, Saat::time_point bitis, const uint64_t *sayac);
+} // namespace olcum_detay
+
+inline bool olcumEtkin() { return olcum_detay::etkin.load(std::memory_order_relaxed); }
+// Ölçümü açar veya kapatır; açılırken önceki istatistikler ve iz olayları silinir
+void olcumEtkinlestir(bool ac);
+// Aşamanın şimdiye kadarki istatistiği (birden çok iş parçacığından güvenle okunur)
+AsamaIstatistigi asamaIstatistigi(OlcumAsamasi asama);
+// Aşamanın izlerde ve durum çubuğunda görünen adı
+const char *asamaAdi(OlcumAsamasi asama);
+const char *sayacAdi(OlcumSayaci sayac);
+// Çağıran iş parçacığına izlerde görünecek bir ad verir
+void olcumIsParcacigiAdi(const char *ad);
+// Saklanan iz olaylarını Chrome iz olayı JSON dosyası olarak yazar
+// (chrome://tracing veya ui.perfetto.dev ile açılır). Halka dolduğunda en eski
+// olaylar atılır; yazılan olay sayısını, dosya açılamazsa -1 döndürür.
+long olcumIziniYaz(const char *yol);
+
+// Bir aşamanın süresini ve sayaçlarını kapsam bitince kaydeder
+class OlcumKapsami {
+public:
+    explicit OlcumKapsami(OlcumAsamasi a) : asama(a), etkin(olcumEtkin()) {
+        if (etkin) {
+            for (int i = 0; i < OS_SAYISI; ++i) sayac[i] = 0;
+            baslangic = olcum_detay::Saat::now();
+        }
+    }
+    ~OlcumKapsami() {
+        if (etkin) olcum_detay::kaydet(asama, baslangic, olcum_detay::Saat::now(), sayac);
+    }
+    OlcumKapsami(const OlcumKapsami &) = delete;
+    OlcumKapsami &operator=(const OlcumKapsami &) = delete;
+
+    void say(OlcumSayaci s, uint64_t miktar) {
+        if (etkin) sayac[s] += miktar;
+    }
+    bool olcuyor() const { return etkin; }
+
+private:
+    OlcumAsamasi asama;
+    bool etkin;
+    olcum_detay::Saat::time_point baslangic;
+    uint64_t sayac[OS_SAYISI];
+};
+
+#endif
@@ -0,0 +1,334 @@
+#include "onbellek.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define SUREC_NO() ((unsigned long)::getpid())
+#else
+#define SUREC_NO() 0ul
+#endif
+
+// Dosyanın başı; diziler başlıktan sonra 8 bayt hizalı olarak gelir
+struct OnbellekBasligi {
+    char sihir[4];          // "SHC1"
+    uint32_t surum;         // MOTOR_SURUMU
+    uint32_t duzen;         // Yapı boyutlarının imzası
+    uint32_t bayraklar;     // B_SATIRLAR, B_AGAC
+    uint64_t ozet;
+    uint64_t metinUzunlugu;
+    uint64_t kok;           // Ağacın kök düğümü
+    uint64_t cop;           // Ağacın çöp sayısı
+    struct {
+        uint64_t konum;     // Dosya başından bayt
+        uint64_t sayi;      // Öğe sayısı
+    } diziler[7];
+};
+
+namespace {
+
+typedef OnbellekBasligi Baslik;
+
+enum { B_SATIRLAR = 1, B_AGAC = 2 };
+enum { D_TOKEN, D_SATIR, D_DUGUM, D_ALT_DUGUM, D_OGE, D_BOLUM, D_SEMBOL, D_SAYISI };
+
+const size_t OGE_BOYUTU[D_SAYISI] = {sizeof(Token),        sizeof(SatirKaydi), sizeof(ParseNode), sizeof(NodeId),
+                                     sizeof(TopLevelItem), sizeof(uint32_t),   sizeof(SymbolRef)};
+
+// Bu derlemenin yapı düzeni; farklı bir derlemenin dosyası okunmaz
+uint32_t duzenImzasi() {
+    return (uint32_t)(sizeof(Token) | sizeof(SatirKaydi) << 6 | sizeof(ParseNode) << 12 |
+                      sizeof(TopLevelItem) << 18 | sizeof(void *) << 24);
+}
+
+// XXH64
+const uint64_t P1 = 0x9E3779B185EBCA87ull;
+const uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+const uint64_t P3 = 0x165667B19E3779F9ull;
+const uint64_t P4 = 0x85EBCA77C2B2AE63ull;
+const uint64_t P5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t dondur(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+inline uint64_t oku64(const unsigned char *p) {
+    uint64_t x;
+    std::memcpy(&x, p, 8);
+    return x;
+}
+inline uint32_t oku32(const unsigned char *p) {
+    uint32_t x;
+    std::memcpy(&x, p, 4);
+    return x;
+}
+inline uint64_t tur(uint64_t acc, uint64_t girdi) {
+    acc += girdi * P2;
+    return dondur(acc, 31) * P1;
+}
+inline uint64_t birlestir(uint64_t acc, uint64_t v) {
+    acc ^= tur(0, v);
+    return acc * P1 + P4;
+}
+
+std::string dosyaAdi(const std::string &dizin, uint64_t ozet, size_t uzunluk) {
+    char ad[64];
+    std::snprintf(ad, sizeof(ad), "%016llx-%llx-v%u.shc", (unsigned long long)ozet,
+                  (unsigned long long)uzunluk, MOTOR_SURUMU);
+    return (std::filesystem::path(dizin) / ad).string();
+}
+
+// Bir enum alanının ham değeri; bozuk bir dosyada tanımsız bir değer olabilir
+template <typename E> uint64_t hamDeger(const E &alan) {
+    typename std::make_unsigned<typename std::underlying_type<E>::type>::type x;
+    std::memcpy(&x, &alan, sizeof(x));
+    return x;
+}
+
+template <typename T> const T *diziBasi(const Baslik *b, int i) {
+    return reinterpret_cast<const T *>(reinterpret_cast<const char *>(b) + b->diziler[i].konum);
+}
+
+// Dizilerin içeriğini tek geçişte denetler
+// Bozuk bir dosya, okuyucuların dizi ve metin dışına taşmasına yol açmamalı.
+// Dizi sınırları başlıkta denetlenmiş olmalıdır.
+bool icerikTutarli(const Baslik *b) {
+    const uint64_t uzunluk = b->metinUzunlugu;
+    const Token *t = diziBasi<Token>(b, D_TOKEN);
+    int64_t onceki = 0;
+    for (uint64_t i = 0; i < b->diziler[D_TOKEN].sayi; ++i) {
+        if (t[i].baslangic < onceki || t[i].bitis < t[i].baslangic || (uint64_t)t[i].bitis > uzunluk ||
+            hamDeger(t[i].tip) > NOKTALAMA) {
+            return false;
+        }
+        onceki = t[i].bitis;
+    }
+    if (b->bayraklar & B_SATIRLAR) {
+        const SatirKaydi *s = diziBasi<SatirKaydi>(b, D_SATIR);
+        uint64_t n = b->diziler[D_SATIR].sayi;
+        if (n == 0 || s[0].baslangic != 0) return false;
+        for (uint64_t i = 0; i < n; ++i) {
+            if ((i > 0 && s[i].baslangic < s[i - 1].baslangic) || (uint64_t)s[i].baslangic > uzunluk ||
+                s[i].durum > LD_KARAKTER_KACIS) {
+                return false;
+            }
+        }
+    }
+    if (!(b->bayraklar & B_AGAC)) return true;
+
+    const uint64_t dugumSayisi = b->diziler[D_DUGUM].sayi, altSayisi = b->diziler[D_ALT_DUGUM].sayi;
+    const uint64_t bolumSayisi = b->diziler[D_BOLUM].sayi;
+    const uint32_t *bolum = diziBasi<uint32_t>(b, D_BOLUM);
+    for (uint64_t i = 0; i < bolumSayisi; ++i) {
+        if (bolum[i] > uzunluk) return false;
+    }
+    // Alt düğümler üst düğümden önce oluşturulur; küçük indeks koşulu döngüleri de dışlar
+    const ParseNode *d = diziBasi<ParseNode>(b, D_DUGUM);
+    const NodeId *alt = diziBasi<NodeId>(b, D_ALT_DUGUM);
+    for (uint64_t i = 0; i < dugumSayisi; ++i) {
+        const ParseNode &n = d[i];
+        if (hamDeger(n.type) > CAST_EXPR || n.segment >= bolumSayisi ||
+            (uint64_t)n.firstChild + n.childCount > altSayisi ||
+            (uint64_t)bolum[n.segment] + n.valueStart + n.valueLength > uzunluk ||
+            (uint64_t)bolum[n.segment] + n.spanStart + n.spanLength > uzunluk) {
+            return false;
+        }
+        for (uint32_t k = 0; k < n.childCount; ++k) {
+            if (alt[n.firstChild + k] >= i) return false;
+        }
+    }
+    if (hamDeger(d[b->kok].type) != PROGRAM || b->cop > dugumSayisi + altSayisi) return false;
+    const TopLevelItem *o = diziBasi<TopLevelItem>(b, D_OGE);
+    for (uint64_t i = 0; i < b->diziler[D_OGE].sayi; ++i) {
+        if (o[i].node >= dugumSayisi || o[i].segment >= bolumSayisi || o[i].start > o[i].nextStart ||
+            o[i].nextStart > uzunluk || o[i].firstNode > o[i].nodeEnd || o[i].nodeEnd > dugumSayisi ||
+            o[i].firstChildId > o[i].childIdEnd || o[i].childIdEnd > altSayisi) {
+            return false;
+        }
+    }
+    const SymbolRef *r = diziBasi<SymbolRef>(b, D_SEMBOL);
+    for (uint64_t i = 0; i < b->diziler[D_SEMBOL].sayi; ++i) {
+        if (r[i].node >= dugumSayisi || hamDeger(d[r[i].node].type) != IDENTIFIER ||
+            hamDeger(r[i].role) > SYMBOL_FUNCTION) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+uint64_t icerikOzeti(const char *metin, size_t uzunluk) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(metin);
+    const unsigned char *son = p + uzunluk;
+    uint64_t h;
+    if (uzunluk >= 32) {
+        uint64_t v1 = P1 + P2, v2 = P2, v3 = 0, v4 = 0 - P1;
+        const unsigned char *sinir = son - 32;
+        do {
+            v1 = tur(v1, oku64(p));
+            v2 = tur(v2, oku64(p + 8));
+            v3 = tur(v3, oku64(p + 16));
+            v4 = tur(v4, oku64(p + 24));
+            p += 32;
+        } while (p <= sinir);
+        h = dondur(v1, 1) + dondur(v2, 7) + dondur(v3, 12) + dondur(v4, 18);
+        h = birlestir(h, v1);
+        h = birlestir(h, v2);
+        h = birlestir(h, v3);
+        h = birlestir(h, v4);
+    } else {
+        h = P5;
+    }
+    h += (uint64_t)uzunluk;
+    for (; p + 8 <= son; p += 8) h = dondur(h ^ tur(0, oku64(p)), 27) * P1 + P4;
+    if (p + 4 <= son) {
+        h = dondur(h ^ (uint64_t)oku32(p) * P1, 23) * P2 + P3;
+        p += 4;
+    }
+    for (; p < son; ++p) h = dondur(h ^ *p * P5, 11) * P1;
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string varsayilanOnbellekDizini() {
+    if (const char *d = std::getenv("SYNTAX_ONBELLEK")) return d;
+    if (const char *d = std::getenv("XDG_CACHE_HOME")) {
+        if (*d) return (std::filesystem::path(d) / "syntax-highlighter").string();
+    }
+    if (const char *d = std::getenv("HOME")) {
+        if (*d) return (std::filesystem::path(d) / ".cache" / "syntax-highlighter").string();
+    }
+    return std::string();
+}
+
+bool onbellegeYaz(const std::string &dizin, const OnbellekIcerigi &icerik) {
+    if (dizin.empty()) return false;
+    std::error_code hata;
+    std::filesystem::create_directories(dizin, hata);
+
+    const void *veri[D_SAYISI] = {};
+    Baslik baslik;
+    std::memset(&baslik, 0, sizeof(baslik));
+    std::memcpy(baslik.sihir, "SHC1", 4);
+    baslik.surum = MOTOR_SURUMU;
+    baslik.duzen = duzenImzasi();
+    baslik.ozet = icerik.ozet;
+    baslik.metinUzunlugu = icerik.metinUzunlugu;
+    baslik.kok = NO_NODE;
+    veri[D_TOKEN] = icerik.tokenlar;
+    baslik.diziler[D_TOKEN].sayi = icerik.tokenSayisi;
+    if (icerik.satirlar) {
+        baslik.bayraklar |= B_SATIRLAR;
+        veri[D_SATIR] = icerik.satirlar;
+        baslik.diziler[D_SATIR].sayi = icerik.satirSayisi;
+    }
+    if (icerik.agac) {
+        const ParseTreeImage &a = *icerik.agac;
+        baslik.bayraklar |= B_AGAC;
+        baslik.kok = a.root;
+        baslik.cop = a.garbage;
+        veri[D_DUGUM] = a.nodes;
+        baslik.diziler[D_DUGUM].sayi = a.nodeCount;
+        veri[D_ALT_DUGUM] = a.childIds;
+        baslik.diziler[D_ALT_DUGUM].sayi = a.childIdCount;
+        veri[D_OGE] = a.items;
+        baslik.diziler[D_OGE].sayi = a.itemCount;
+        veri[D_BOLUM] = a.segmentBase;
+        baslik.diziler[D_BOLUM].sayi = a.segmentCount;
+        veri[D_SEMBOL] = a.symbolRefs;
+        baslik.diziler[D_SEMBOL].sayi = a.symbolRefCount;
+    }
+    uint64_t konum = sizeof(Baslik);
+    for (int i = 0; i < D_SAYISI; ++i) {
+        baslik.diziler[i].konum = konum;
+        konum += (baslik.diziler[i].sayi * OGE_BOYUTU[i] + 7) & ~(uint64_t)7;
+    }
+
+    // Aynı girdiyi yazan iş parçacıkları ve süreçler farklı geçici dosyalar kullanır
+    static std::atomic<unsigned> sayac(0);
+    std::string yol = dosyaAdi(dizin, icerik.ozet, icerik.metinUzunlugu);
+    char ek[48];
+    std::snprintf(ek, sizeof(ek), ".%lu.%u.tmp", SUREC_NO(), sayac.fetch_add(1));
+    std::string gecici = yol + ek;
+    FILE *f = std::fopen(gecici.c_str(), "wb");
+    if (!f) return false;
+    static const char dolgu[8] = {};
+    std::fwrite(&baslik, sizeof(baslik), 1, f);
+    for (int i = 0; i < D_SAYISI; ++i) {
+        size_t bayt = baslik.diziler[i].sayi * OGE_BOYUTU[i];
+        if (bayt) std::fwrite(veri[i], 1, bayt, f);
+        if (bayt % 8) std::fwrite(dolgu, 1, 8 - bayt % 8, f);
+    }
+    bool tamam = std::ferror(f) == 0;
+    if (std::fclose(f) != 0) tamam = false;
+    if (tamam) {
+        std::filesystem::rename(gecici, yol, hata);
+        tamam = !hata;
+    }
+    if (!tamam) std::filesystem::remove(gecici, hata);
+    return tamam;
+}
+
+bool OnbellekGirdisi::ac(const std::string &dizin, uint64_t ozet, size_t metinUzunlugu) {
+    kapat();
+    if (dizin.empty() || !dosya.ac(dosyaAdi(dizin, ozet, metinUzunlugu).c_str())) return false;
+    std::string_view icerik = dosya.metin();
+    const Baslik *b = reinterpret_cast<const Baslik *>(icerik.data());
+    bool gecerli = icerik.size() >= sizeof(Baslik) && (uintptr_t)icerik.data() % 8 == 0 &&
+                   std::memcmp(b->sihir, "SHC1", 4) == 0 && b->surum == MOTOR_SURUMU &&
+                   b->duzen == duzenImzasi() && b->ozet == ozet && b->metinUzunlugu == metinUzunlugu;
+    for (int i = 0; gecerli && i < D_SAYISI; ++i) {
+        uint64_t konum = b->diziler[i].konum, sayi = b->diziler[i].sayi;
+        gecerli = konum % 8 == 0 && konum <= icerik.size() && sayi <= (icerik.size() - konum) / OGE_BOYUTU[i];
+    }
+    if (gecerli && (b->bayraklar & B_AGAC)) {
+        gecerli = b->kok < b->diziler[D_DUGUM].sayi && b->diziler[D_BOLUM].sayi > 0;
+    }
+    if (gecerli) gecerli = icerikTutarli(b);
+    if (!gecerli) {
+        dosya.kapat();
+        return false;
+    }
+    baslik = b;
+    return true;
+}
+
+void OnbellekGirdisi::kapat() {
+    baslik = nullptr;
+    dosya.kapat();
+}
+
+const void *OnbellekGirdisi::dizi(int i) const {
+    return dosya.metin().data() + baslik->diziler[i].konum;
+}
+
+const Token *OnbellekGirdisi::tokenlar() const { return static_cast<const Token *>(dizi(D_TOKEN)); }
+size_t OnbellekGirdisi::tokenSayisi() const { return (size_t)baslik->diziler[D_TOKEN].sayi; }
+bool OnbellekGirdisi::satirlarVar() const { return (baslik->bayraklar & B_SATIRLAR) != 0; }
+const SatirKaydi *OnbellekGirdisi::satirlar() const { return static_cast<const SatirKaydi *>(dizi(D_SATIR)); }
+size_t OnbellekGirdisi::satirSayisi() const { return (size_t)baslik->diziler[D_SATIR].sayi; }
+bool OnbellekGirdisi::agacVar() const { return (baslik->bayraklar & B_AGAC) != 0; }
+
+ParseTreeImage OnbellekGirdisi::agac() const {
+    ParseTreeImage a;
+    a.nodes = static_cast<const ParseNode *>(dizi(D_DUGUM));
+    a.nodeCount = (size_t)baslik->diziler[D_DUGUM].sayi;
+    a.childIds = static_cast<const NodeId *>(dizi(D_ALT_DUGUM));
+    a.childIdCount = (size_t)baslik->diziler[D_ALT_DUGUM].sayi;
+    a.items = static_cast<const TopLevelItem *>(dizi(D_OGE));
+    a.itemCount = (size_t)baslik->diziler[D_OGE].sayi;
+    a.segmentBase = static_cast<const uint32_t *>(dizi(D_BOLUM));
+    a.segmentCount = (size_t)baslik->diziler[D_BOLUM].sayi;
+    a.symbolRefs = static_cast<const SymbolRef *>(dizi(D_SEMBOL));
+    a.symbolRefCount = (size_t)baslik->diziler[D_SEMBOL].sayi;
+    a.root = (NodeId)baslik->kok;
+    a.garbage = (size_t)baslik->cop;
+    return a;
+}
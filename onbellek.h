@@ -0,0 +1,80 @@
+#ifndef ONBELLEK_H
+#define ONBELLEK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "dosya_girdisi.h"
+#include "lexer.h"
+#include "parser.h"
+
+// İçerik özetiyle anahtarlanan disk önbelleği
+// Bir metnin token'ları, satır kayıtları ve sözdizimi ağacı, metnin içerik
+// özeti ve motor sürümüyle adlandırılan tek bir dosyada, bellekteki
+// düzenleriyle saklanır. Okurken dosya belleğe eşlenir ve diziler
+// kopyalanmadan doğrudan kullanılır; değişmemiş bir dosyayı yeniden açmak
+// metnin özetini hesaplamaya ve dizileri bir kez denetlemeye mal olur.
+//
+// Dosyalar yerel makineye özgüdür: yapıların boyutları başlıkta saklanır ve
+// uyuşmazsa girdi yok sayılır. Dizin istenildiği zaman silinebilir.
+
+// Token, satır kaydı veya düğüm üretimi değiştiğinde artırılır;
+// eski sürümün dosyaları bir daha eşleşmez
+const uint32_t MOTOR_SURUMU = 6;
+
+// Metnin 64 bitlik içerik özeti (XXH64)
+uint64_t icerikOzeti(const char *metin, size_t uzunluk);
+
+// $SYNTAX_ONBELLEK, yoksa $XDG_CACHE_HOME/syntax-highlighter, yoksa
+// ~/.cache/syntax-highlighter. SYNTAX_ONBELLEK boş verilmişse önbellek
+// kapalıdır ve boş metin döndürülür.
+std::string varsayilanOnbellekDizini();
+
+// Önbelleğe yazılacak veriler; satırlar ve ağaç isteğe bağlıdır
+struct OnbellekIcerigi {
+    uint64_t ozet = 0;            // icerikOzeti(metin)
+    size_t metinUzunlugu = 0;
+    const Token *tokenlar = nullptr;
+    size_t tokenSayisi = 0;
+    const SatirKaydi *satirlar = nullptr;   // nullptr: satır kaydı yok
+    size_t satirSayisi = 0;
+    const ParseTreeImage *agac = nullptr;   // nullptr: ağaç yok
+};
+
+// Girdiyi dizine yazar (dizin yoksa oluşturulur)
+// Dosya önce geçici bir adla yazılıp yerine taşınır; aynı girdiyi yazan
+// başka bir süreç yarım bir dosya görmez. Yazılamazsa false döndürür.
+bool onbellegeYaz(const std::string &dizin, const OnbellekIcerigi &icerik);
+
+struct OnbellekBasligi;
+
+// Belleğe eşlenmiş bir önbellek girdisi
+// Diziler girdi açık kaldığı sürece geçerlidir.
+class OnbellekGirdisi {
+public:
+    OnbellekGirdisi() : baslik(nullptr) {}
+    OnbellekGirdisi(const OnbellekGirdisi &) = delete;
+    OnbellekGirdisi &operator=(const OnbellekGirdisi &) = delete;
+
+    // Metnin girdisini açar; yoksa, sürümü eskiyse veya bozuksa false döndürür
+    // Dizilerin içeriği açılırken bir kez denetlenir (O(n))
+    bool ac(const std::string &dizin, uint64_t ozet, size_t metinUzunlugu);
+    void kapat();
+
+    const Token *tokenlar() const;
+    size_t tokenSayisi() const;
+    bool satirlarVar() const;
+    const SatirKaydi *satirlar() const;
+    size_t satirSayisi() const;
+    bool agacVar() const;
+    ParseTreeImage agac() const;
+
+private:
+    EslenmisDosya dosya;
+    const OnbellekBasligi *baslik;  // Eşlenen dosyanın başı (nullptr: açık değil)
+
+    const void *dizi(int i) const;
+};
+
+#endif
@@ -1,652 +1,443 @@
-#include <FL/Fl.H>
-#include <FL/Fl_Window.H>
-#include <FL/Fl_Tree.H>
-#include <FL/Fl_Text_Buffer.H>
-#include <string>
-#include <vector>
-#include <memory>
+#include "parse_tree.h"
+#include "olcum.h"
+#include <functional>
+#include <algorithm>
 
-// Sözdizimi ağacı için düğüm tipleri
-// Her düğüm tipi, kodun farklı bir yapısal öğesini temsil eder
-enum NodeType {
-    PROGRAM,            // Programın kök düğümü
-    FUNCTION_DEF,       // Fonksiyon tanımı
-    VARIABLE_DECL,      // Değişken tanımı
-    PARAM_LIST,         // Parametre listesi
-    PARAM,              // Tek bir parametre
-    STATEMENT,          // Genel ifade
-    IF_STATEMENT,       // If koşul ifadesi
-    WHILE_STATEMENT,    // While döngü ifadesi
-    FOR_STATEMENT,      // For döngü ifadesi
-    RETURN_STATEMENT,   // Return ifadesi
-    EXPRESSION,         // Genel ifade
-    BINARY_EXPR,        // İkili işlem (+, -, *, /, vb.)
-    UNARY_EXPR,         // Tekli işlem
-    ASSIGNMENT_EXPR,    // Atama ifadesi
-    LITERAL,            // Sabit değer (sayı, metin, karakter)
-    IDENTIFIER,         // Tanımlayıcı (değişken, fonksiyon adı)
-    TYPE,               // Veri tipi
-    BLOCK_STATEMENT     // Kod bloğu
-};
-
-// Sözdizimi ağacı düğüm yapısı
-// Her düğüm, kodun bir parçasını ve onun alt öğelerini temsil eder
-struct ParseNode {
-    NodeType type;      // Düğümün tipi
-    std::string value;  // Düğümün değeri (operatör, tanımlayıcı, vb.)
-    std::vector<std::shared_ptr<ParseNode>> children;  // Alt düğümler
-    ParseNode(NodeType t, const std::string& v = "") : type(t), value(v) {}
-};
-
-// Yukarıdan aşağıya sözdizimi çözümleyici sınıfı
-// Kaynak kodu okuyup sözdizimi ağacını oluşturur
-class Parser {
-public:
-    Fl_Text_Buffer* buffer;    // Kaynak kod metni
-    std::string currentToken;  // Şu anki işlenen token
-    size_t position;          // Metin içindeki konum
-
-private:
-    // Token'ın bir veri tipi olup olmadığını kontrol eder
-    bool isType(const std::string& token) {
-        static const std::vector<std::string> types = {
-            "int", "float", "double", "char", "string", "void", "bool"
-        };
-        return std::find(types.begin(), types.end(), token) != types.end();
+void BackgroundParser::follow(const ParseSnapshot& job) {
+    if (!job.incremental) {
+        job.document.oku(0, job.document.uzunluk(), text);
+        job.tokenStore.kopyala(tokens);
+        return;
     }
-
-    // Token'ın bir anahtar kelime olup olmadığını kontrol eder
-    bool isKeyword(const std::string& token) {
-        static const std::vector<std::string> keywords = {
-            "if", "else", "while", "for", "return", "break", "continue"
-        };
-        return std::find(keywords.begin(), keywords.end(), token) != keywords.end();
+    // Aralığın dışındaki metin ve token'lar değişmemiştir; sonrası yalnızca kayar
+    const DegisimAraligi& edit = job.edit;
+    text.replace(edit.baslangic, edit.eskiBitis - edit.baslangic, edit.yeniBitis - edit.baslangic, '\0');
+    char* out = &text[edit.baslangic];
+    job.document.gez(edit.baslangic, edit.yeniBitis, [&out](const char* p, size_t n) {
+        std::copy(p, p + n, out);
+        out += n;
+    });
+    auto firstAt = [this](int offset) {
+        return std::lower_bound(tokens.begin(), tokens.end(), offset,
+                                [](const Token& t, int k) { return t.baslangic < k; });
+    };
+    auto from = firstAt(edit.baslangic), to = firstAt(edit.eskiBitis);
+    const int delta = edit.yeniBitis - edit.eskiBitis;
+    if (delta != 0) {
+        for (auto t = to; t != tokens.end(); ++t) {
+            t->baslangic += delta;
+            t->bitis += delta;
+        }
     }
+    size_t at = from - tokens.begin();
+    tokens.erase(from, to);
+    tokens.insert(tokens.begin() + at, job.changed.begin(), job.changed.end());
+}
 
-    // Operatörün önceliğini döndürür
-    // Daha yüksek sayı, daha yüksek öncelik anlamına gelir
-    int getOperatorPrecedence(const std::string& op) {
-        if (op == "*" || op == "/" || op == "%") return 3;  // Çarpma, bölme, mod
-        if (op == "+" || op == "-") return 2;               // Toplama, çıkarma
-        if (op == "=") return 1;                            // Atama
-        return 0;
+bool BackgroundParser::apply(Parser& parser, const ParseSnapshot& job) {
+    std::lock_guard<std::mutex> treeLock(treeMutex);
+    // seed() metni daha yeni bir revizyona getirdiyse bu isteğin düzenlemesi ona uymaz
+    if (job.generation < seedGeneration) return false;
+    OlcumKapsami timer(OA_PARSE);
+    // Metin her istekte ilerler; ağaç ancak ayrıştırma biterse ona yetişir
+    follow(job);
+    treeCurrent = false;
+    bool incremental = treeValid && job.incremental;
+    DegisimAraligi edit = job.edit;
+    if (incremental && hasUnparsedEdit) edit = degisimleriBirlestir(unparsedEdit, edit);
+    parser.setCancellation(&generation, job.generation);
+    size_t nodesBefore = tree.nodeCount();
+    uint64_t treeGeneration = tree.image().generation;
+    if (incremental) {
+        parser.reparse(text, tokens, edit, tree);
+    } else {
+        parser.parse(text, tokens, tree);
     }
-
-    // Gereksiz ifade düğümlerini temizler
-    // Tek bir alt düğümü olan ifade düğümlerini kaldırır
-    std::shared_ptr<ParseNode> cleanExpressionNode(std::shared_ptr<ParseNode> node) {
-        if (node->type == EXPRESSION && node->children.size() == 1) {
-            return node->children[0];  // Tek alt düğümü olan ifadeyi kaldır
-        }
-        return node;
+    // reparse() çöp çoğalınca ağacı baştan kurar
+    bool rebuilt = tree.image().generation != treeGeneration;
+    if (timer.olcuyor()) {
+        // Artımlı ayrıştırma düğümleri sona ekler
+        size_t nodesAfter = tree.nodeCount();
+        timer.say(OS_BAYT, rebuilt ? text.size() : (size_t)(edit.yeniBitis - edit.baslangic));
+        timer.say(OS_DUGUM, rebuilt ? nodesAfter : nodesAfter - nodesBefore);
     }
-
-    // Yorum satırlarını atlar
-    void skipComments() {
-        std::string text = buffer->text();
-        // Tek satırlık yorum (//)
-        if (position + 1 < text.length() && 
-            text[position] == '/' && text[position + 1] == '/') {
-            position += 2;  // // karakterlerini atla
-            // Satır sonuna kadar ilerle
-            while (position < text.length() && text[position] != '\n') {
-                position++;
-            }
-            position++;  // \n karakterini atla
-        }
-        // Çok satırlı yorum (/* */)
-        else if (position + 1 < text.length() && 
-                 text[position] == '/' && text[position + 1] == '*') {
-            position += 2;  // /* karakterlerini atla
-            // */ karakterlerini bulana kadar ilerle
-            while (position + 1 < text.length() && 
-                   !(text[position] == '*' && text[position + 1] == '/')) {
-                position++;
-            }
-            position += 2;  // */ karakterlerini atla
+    if (parser.cancelled()) {
+        // Artımlı ayrıştırmada ağacın yapısı eski metne göre geçerli kalır ve
+        // bir sonraki istekte temel olur; düzenleme o isteğinkiyle birleştirilir.
+        // Değerleri artık 'text'te olmadığından o zamana kadar okunmaz.
+        // Baştan kurulum yarıda kaldıysa ağaçta yalnızca ilk öğeler vardır.
+        if (incremental && !rebuilt) {
+            unparsedEdit = edit;
+            hasUnparsedEdit = true;
+        } else {
+            treeValid = false;
+            hasUnparsedEdit = false;
         }
+        return false;
     }
+    treeValid = true;
+    treeCurrent = true;
+    treeRevision = job.revision;
+    hasUnparsedEdit = false;
+    // Dizin yalnızca yeni öğelerin kayıtlarını işler; süre ayrıştırmaya katılır
+    symbols.update(0, tree);
+    return true;
+}
 
-    // Bir sonraki token'ı alır
-    // Boşlukları ve yorumları atlar ve bir sonraki anlamlı token'ı döndürür
-    std::string getNextToken() {
-        std::string text = buffer->text();
-        while (position < text.length()) {
-            // Boşlukları atla
-            if (isspace(text[position])) {
-                position++;
-                continue;
-            }
-            // Yorumları atla
-            if (position + 1 < text.length() && 
-                text[position] == '/' && 
-                (text[position + 1] == '/' || text[position + 1] == '*')) {
-                skipComments();
-                continue;
-            }
-            break;  // Anlamlı bir karakter bulundu
-        }
-        if (position >= text.length()) {
-            return "";
-        }
-        size_t start = position;
-        // Tanımlayıcı (değişken/fonksiyon adı)
-        if (isalpha(text[position]) || text[position] == '_') {
-            while (position < text.length() && (isalnum(text[position]) || text[position] == '_')) {
-                position++;
-            }
-        }
-        // Sayı
-        else if (isdigit(text[position])) {
-            while (position < text.length() && (isdigit(text[position]) || text[position] == '.')) {
-                position++;
-            }
-        }
-        // Metin (çift tırnak içinde)
-        else if (text[position] == '"') {
-            position++;
-            while (position < text.length() && text[position] != '"') {
-                if (text[position] == '\\') position++;  // Kaçış karakterlerini atla
-                position++;
-            }
-            position++;
-        }
-        // Karakter (tek tırnak içinde)
-        else if (text[position] == '\'') {
-            position++;
-            while (position < text.length() && text[position] != '\'') {
-                if (text[position] == '\\') position++;  // Kaçış karakterlerini atla
-                position++;
-            }
-            position++;
-        }
-        // Operatör veya diğer karakterler
-        else {
-            position++;
+void BackgroundParser::run() {
+    olcumIsParcacigiAdi("ayristirici");
+    Parser parser;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeup.wait(lock, [this] { return stopping || pending; });
+        if (stopping) return;
+        std::unique_ptr<ParseSnapshot> job = std::move(pending);
+        unsigned long jobGeneration = job->generation;
+        lock.unlock();
+        bool done = apply(parser, *job);
+        // Bütün token'ların kopyası yalnızca baştan ayrıştırmada gerekir; tutulmaz
+        if (!job->incremental) job->tokenStore = TokenDeposu();
+        lock.lock();
+        recycle(std::move(job));
+        // Bu arada eskiyen sonuç bildirilmez; daha yenisi yoldadır
+        if (done && jobGeneration == generation.load()) {
+            Fl::awake(onReady, onReadyData);
         }
-        return text.substr(start, position - start);
     }
+}
 
-    // Temel ifadeleri ayrıştırır (tanımlayıcılar, sabitler, parantezli ifadeler)
-    std::shared_ptr<ParseNode> parsePrimary() {
-        // Parantezli ifade
-        if (currentToken == "(") {
-            currentToken = getNextToken();
-            auto expr = cleanExpressionNode(parseExpression());
-            if (currentToken == ")") {
-                currentToken = getNextToken();
-            }
-            return expr;
-        }
-        // Tanımlayıcı (değişken/fonksiyon adı)
-        if (isalpha(currentToken[0]) || currentToken[0] == '_') {
-            auto node = std::make_shared<ParseNode>(IDENTIFIER, currentToken);
-            currentToken = getNextToken();
-            return node;
-        }
-        // Sabit değer (sayı, metin, karakter)
-        else if (isdigit(currentToken[0]) || currentToken[0] == '"' || currentToken[0] == '\'') {
-            auto node = std::make_shared<ParseNode>(LITERAL, currentToken);
-            currentToken = getNextToken();
-            return node;
-        }
-        // Hata durumu
-        currentToken = getNextToken();
-        return std::make_shared<ParseNode>(EXPRESSION);
+BackgroundParser::BackgroundParser(Fl_Awake_Handler handler, void* data)
+    : generation(0), stopping(false), onReady(handler), onReadyData(data), treeRevision(0),
+      seedGeneration(0), treeValid(false), treeCurrent(false), hasUnparsedEdit(false), unparsedEdit{0, 0, 0} {
+    worker = std::thread(&BackgroundParser::run, this);
+}
+
+BackgroundParser::~BackgroundParser() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        generation++;  // Süren ayrıştırmayı iptal et
     }
+    wakeup.notify_one();
+    worker.join();
+}
 
-    // İfadeleri operatör önceliğine göre ayrıştırır
-    std::shared_ptr<ParseNode> parseExpression(int minPrecedence = 0) {
-        auto left = cleanExpressionNode(parsePrimary());
-        // Operatörleri işle
-        while (!currentToken.empty() && 
-               (currentToken == "+" || currentToken == "-" || 
-                currentToken == "*" || currentToken == "/" || 
-                currentToken == "%" || currentToken == "=")) {
-            std::string op = currentToken;
-            int precedence = getOperatorPrecedence(op);
-            // Operatör önceliği kontrolü
-            if (precedence < minPrecedence) {
-                break;
-            }
-            currentToken = getNextToken();
-            auto right = cleanExpressionNode(parseExpression(precedence + 1));
-            // İkili işlem düğümü oluştur
-            if (!op.empty()) {
-                auto binaryNode = std::make_shared<ParseNode>(BINARY_EXPR);
-                binaryNode->value = op;
-                binaryNode->children.push_back(left);
-                binaryNode->children.push_back(right);
-                left = binaryNode;
+void BackgroundParser::request(const BelgeGoruntusu& document, const TokenDeposu& tokenStore,
+                               unsigned long revision, const DegisimAraligi* edit) {
+    std::unique_ptr<ParseSnapshot> snapshot, dropped;
+    bool incremental = edit != nullptr;
+    DegisimAraligi range = edit ? *edit : DegisimAraligi{0, 0, 0};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = std::move(spare);
+        // Başlanmamış istek atılır; düzenlemesi bu isteğinkine katılır.
+        // İş parçacığı yalnızca bu iş parçacığının koyduğu isteği alır, bu
+        // yüzden istek kilit dışında hazırlanırken yeni bir bekleyen oluşmaz.
+        if (pending) {
+            if (pending->incremental && incremental) {
+                range = degisimleriBirlestir(pending->edit, range);
+            } else {
+                incremental = false;
             }
+            dropped = std::move(pending);
         }
-        return left;
     }
-    // Atama ifadelerini ayrıştırır
-    std::shared_ptr<ParseNode> parseAssignment() {
-        auto left = parsePrimary();
-        if (currentToken == "=") {
-            auto assignNode = std::make_shared<ParseNode>(ASSIGNMENT_EXPR);
-            assignNode->children.push_back(left);
-            currentToken = getNextToken();
-            assignNode->children.push_back(parseExpression());
-            return assignNode;
-        }
-        return left;
+    if (!snapshot) snapshot.reset(new ParseSnapshot());
+    // Kopya kilit dışında alınır; iş parçacığı bu sırada çalışmaya devam eder
+    snapshot->document = document;
+    snapshot->revision = revision;
+    snapshot->incremental = incremental;
+    snapshot->edit = range;
+    snapshot->changed.clear();
+    if (incremental) {
+        tokenStore.ekleKopyala(tokenStore.ilkToken(range.baslangic), tokenStore.ilkToken(range.yeniBitis),
+                               snapshot->changed);
+    } else {
+        snapshot->tokenStore = tokenStore;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot->generation = ++generation;
+        if (dropped) recycle(std::move(dropped));
+        pending = std::move(snapshot);
     }
+    wakeup.notify_one();
+}
 
-    // Değişken tanımlamalarını ayrıştırır
-    std::shared_ptr<ParseNode> parseVariableDecl() {
-        auto node = std::make_shared<ParseNode>(VARIABLE_DECL);
-        // Veri tipini ayrıştır
-        node->children.push_back(std::make_shared<ParseNode>(TYPE, currentToken));
-        currentToken = getNextToken();
-        // Değişken adını ayrıştır
-        node->children.push_back(std::make_shared<ParseNode>(IDENTIFIER, currentToken));
-        currentToken = getNextToken();
-        // İlk değer ataması varsa ayrıştır
-        if (currentToken == "=") {
-            currentToken = getNextToken();
-            node->children.push_back(parseExpression());
-        }
-        // Noktalı virgülü atla
-        if (currentToken == ";") {
-            currentToken = getNextToken();
-        }
-        return node;
+void BackgroundParser::seed(const BelgeGoruntusu& document, const TokenDeposu& tokenStore,
+                            unsigned long revision, const ParseTreeImage& image) {
+    unsigned long seeded;
+    {
+        // Bekleyen veya süren istekler eskidir
+        std::lock_guard<std::mutex> lock(mutex);
+        seeded = ++generation;
+        if (pending) recycle(std::move(pending));
     }
+    std::lock_guard<std::mutex> treeLock(treeMutex);
+    seedGeneration = seeded;
+    document.oku(0, document.uzunluk(), text);
+    tokenStore.kopyala(tokens);
+    tree.assign(image, text);
+    symbols.update(0, tree);
+    treeRevision = revision;
+    treeValid = true;
+    treeCurrent = true;
+    hasUnparsedEdit = false;
+}
 
-    // Parametreleri ayrıştırır
-    std::shared_ptr<ParseNode> parseParameter() {
-        auto param = std::make_shared<ParseNode>(PARAM);
-        // Parametre tipini ayrıştır
-        if (isType(currentToken)) {
-            param->children.push_back(std::make_shared<ParseNode>(TYPE, currentToken));
-            currentToken = getNextToken();
-            // Parametre adını ayrıştır
-            if (!isKeyword(currentToken)) {
-                param->children.push_back(std::make_shared<ParseNode>(IDENTIFIER, currentToken));
-                currentToken = getNextToken();
-            }
-        }
-        return param;
+std::string ParseTreeWindow::entryLabel(const ParseTree& parseTree, const DisplayEntry& entry) {
+    if (entry.role) return entry.role;
+    NodeType type = parseTree.type(entry.node);
+    std::string label = nodeTypeName(type);
+    std::string_view value = parseTree.value(entry.node);
+    if (!value.empty() && type != IF_STATEMENT && type != WHILE_STATEMENT && type != FOR_STATEMENT) {
+        label += ": ";
+        label += value;
     }
+    return label;
+}
 
-    // Kod bloklarını ayrıştırır
-    std::shared_ptr<ParseNode> parseBlock() {
-        auto block = std::make_shared<ParseNode>(BLOCK_STATEMENT);
-        while (currentToken != "}" && !currentToken.empty()) {
-            // Noktalı virgülleri atla
-            if (currentToken == ";") {
-                currentToken = getNextToken();
-                continue;
-            }
-            // İfadeleri ayrıştır
-            auto stmt = parseStatement();
-            if (stmt->type != EXPRESSION || !stmt->children.empty()) {
-                block->children.push_back(stmt);
-            }
-        }
-        if (currentToken == "}") {
-            currentToken = getNextToken();
-        }
-        return block;
+uint64_t ParseTreeWindow::entryHash(const ParseTree& parseTree, const DisplayEntry& entry) {
+    uint64_t h = parseTree.hash(entry.node);
+    if (entry.role) h = (h ^ std::hash<std::string_view>()(entry.role)) * 0x100000001B3ull;
+    return h;
+}
+
+size_t ParseTreeWindow::addEntry(const ParseTree& parseTree, Fl_Tree_Item* parent, const DisplayEntry& entry, int pos) {
+    std::string label = entryLabel(parseTree, entry);
+    Fl_Tree_Item* item = pos < 0 ? tree->add(parent, label.c_str()) : tree->insert(parent, label.c_str(), pos);
+    item->user_data(reinterpret_cast<void*>((uintptr_t)entryHash(parseTree, entry)));
+    item->open();
+    size_t added = 1;
+    for (uint32_t i = 0; i < entryChildCount(parseTree, entry); ++i) {
+        added += addEntry(parseTree, item, entryChild(parseTree, entry, i), -1);
     }
+    return added;
+}
 
-    // İfadeleri ayrıştırır (if, while, for, return, değişken tanımı, atama)
-    std::shared_ptr<ParseNode> parseStatement() {
-        if (currentToken == "if") {
-            return parseIfStatement();
-        } else if (currentToken == "while") {
-            return parseWhileStatement();
-        } else if (currentToken == "for") {
-            return parseForStatement();
-        } else if (currentToken == "return") {
-            return parseReturnStatement();
-        } else if (isType(currentToken)) {
-            return parseVariableDecl();
-        } else {
-            auto stmt = parseAssignment();
-            if (currentToken == ";") {
-                currentToken = getNextToken();
-            }
-            return stmt;
+void ParseTreeWindow::removeItem(Fl_Tree_Item* item) {
+    for (Fl_Tree_Item* i = selectedItem; i; i = i->parent()) {
+        if (i == item) {
+            selectedItem = nullptr;
+            break;
         }
     }
+    tree->remove(item);
+}
 
-    // If ifadelerini ayrıştırır
-    std::shared_ptr<ParseNode> parseIfStatement() {
-        auto node = std::make_shared<ParseNode>(IF_STATEMENT);
-        currentToken = getNextToken(); // if'i atla
-        // Koşul ifadesini ayrıştır
-        if (currentToken == "(") {
-            currentToken = getNextToken();
-            node->children.push_back(parseExpression());
-            if (currentToken == ")") {
-                currentToken = getNextToken();
-            }
-        }
-        // If bloğunu ayrıştır
-        if (currentToken == "{") {
-            currentToken = getNextToken();
-            node->children.push_back(parseBlock());
-            if (currentToken == "}") {
-                currentToken = getNextToken();
-            }
-        }
-        // Else bloğunu ayrıştır
-        if (currentToken == "else") {
-            currentToken = getNextToken();
-            if (currentToken == "{") {
-                currentToken = getNextToken();
-                node->children.push_back(parseBlock());
-                if (currentToken == "}") {
-                    currentToken = getNextToken();
-                }
-            }
-        }
-        return node;
+void ParseTreeWindow::syncEntry(const ParseTree& parseTree, Fl_Tree_Item* item, const DisplayEntry& entry) {
+    uint64_t h = entryHash(parseTree, entry);
+    if (itemHash(item) == h) return;
+    std::string label = entryLabel(parseTree, entry);
+    if (label != item->label()) item->label(label.c_str());
+    item->user_data(reinterpret_cast<void*>((uintptr_t)h));
+
+    const int newCount = (int)entryChildCount(parseTree, entry);
+    const int oldCount = item->children();
+    // Baştan ve sondan değişmeyen alt öğeleri atla
+    int prefix = 0;
+    while (prefix < newCount && prefix < oldCount &&
+           itemHash(item->child(prefix)) == entryHash(parseTree, entryChild(parseTree, entry, prefix))) {
+        ++prefix;
     }
-    // While döngülerini ayrıştırır
-    std::shared_ptr<ParseNode> parseWhileStatement() {
-        auto node = std::make_shared<ParseNode>(WHILE_STATEMENT);
-        currentToken = getNextToken(); // while'i atla
-        // Koşul ifadesini ayrıştır
-        if (currentToken == "(") {
-            currentToken = getNextToken();
-            node->children.push_back(parseExpression());
-            if (currentToken == ")") {
-                currentToken = getNextToken();
-            }
-        }
-        // While bloğunu ayrıştır
-        if (currentToken == "{") {
-            currentToken = getNextToken();
-            node->children.push_back(parseBlock());
-            if (currentToken == "}") {
-                currentToken = getNextToken();
-            }
-        }
-        return node;
+    int suffix = 0;
+    while (suffix < newCount - prefix && suffix < oldCount - prefix &&
+           itemHash(item->child(oldCount - 1 - suffix)) ==
+               entryHash(parseTree, entryChild(parseTree, entry, newCount - 1 - suffix))) {
+        ++suffix;
     }
-    // For döngülerini ayrıştırır
-    std::shared_ptr<ParseNode> parseForStatement() {
-        auto node = std::make_shared<ParseNode>(FOR_STATEMENT);
-        currentToken = getNextToken(); // for'u atla
-        if (currentToken == "(") {
-            currentToken = getNextToken();
-            // Başlangıç ifadesi
-            node->children.push_back(parseExpression());
-            if (currentToken == ";") {
-                currentToken = getNextToken();
-            }
-            // Koşul ifadesi
-            node->children.push_back(parseExpression());
-            if (currentToken == ";") {
-                currentToken = getNextToken();
-            }
-            // Artırma ifadesi
-            node->children.push_back(parseExpression());
-            if (currentToken == ")") {
-                currentToken = getNextToken();
-            }
-        }
-        // For bloğunu ayrıştır
-        if (currentToken == "{") {
-            currentToken = getNextToken();
-            node->children.push_back(parseBlock());
-            if (currentToken == "}") {
-                currentToken = getNextToken();
-            }
-        }
-        return node;
+    // Aradaki öğeler sırayla eşlenir; fazlası silinir, eksiği eklenir
+    const int oldMiddle = oldCount - prefix - suffix;
+    const int newMiddle = newCount - prefix - suffix;
+    for (int i = 0; i < std::min(oldMiddle, newMiddle); ++i) {
+        syncEntry(parseTree, item->child(prefix + i), entryChild(parseTree, entry, prefix + i));
     }
-    // Return ifadelerini ayrıştırır
-    std::shared_ptr<ParseNode> parseReturnStatement() {
-        auto node = std::make_shared<ParseNode>(RETURN_STATEMENT);
-        currentToken = getNextToken(); // return'u atla
-        // Dönüş değerini ayrıştır
-        node->children.push_back(parseExpression());
-        if (currentToken == ";") {
-            currentToken = getNextToken();
-        }
-        return node;
+    for (int i = newMiddle; i < oldMiddle; ++i) {
+        removeItem(item->child(prefix + newMiddle));
     }
-    // Fonksiyon tanımlarını ayrıştırır
-    std::shared_ptr<ParseNode> parseFunctionDef() {
-        auto node = std::make_shared<ParseNode>(FUNCTION_DEF);
-        // Dönüş tipini ayrıştır
-        if (isType(currentToken)) {
-            node->children.push_back(std::make_shared<ParseNode>(TYPE, currentToken));
-            currentToken = getNextToken();
-        }
-        // Fonksiyon adını ayrıştır
-        if (!isKeyword(currentToken)) {
-            node->children.push_back(std::make_shared<ParseNode>(IDENTIFIER, currentToken));
-            currentToken = getNextToken();
-        }
-        // Parametre listesini ayrıştır
-        auto paramList = std::make_shared<ParseNode>(PARAM_LIST);
-        node->children.push_back(paramList);
-        if (currentToken == "(") {
-            currentToken = getNextToken();
-            // Parametreleri ayrıştır
-            while (currentToken != ")" && !currentToken.empty()) {
-                if (isType(currentToken)) {
-                    paramList->children.push_back(parseParameter());
-                    if (currentToken == ",") {
-                        currentToken = getNextToken();
-                    }
-                } else {
-                    currentToken = getNextToken();
-                }
-            }
-            currentToken = getNextToken(); // )'yi atla
-        }
-        // Fonksiyon gövdesini ayrıştır
-        if (currentToken == "{") {
-            currentToken = getNextToken();
-            node->children.push_back(parseBlock());
-            if (currentToken == "}") {
-                currentToken = getNextToken();
-            }
+    if (oldMiddle < newMiddle) {
+        OlcumKapsami timer(OA_AGAC_EKLE);
+        for (int i = oldMiddle; i < newMiddle; ++i) {
+            timer.say(OS_OGE, addEntry(parseTree, item, entryChild(parseTree, entry, prefix + i), prefix + i));
         }
-        return node;
     }
+}
 
-public:
-    // Yapıcı fonksiyon
-    Parser(Fl_Text_Buffer* buf) : buffer(buf), position(0) {}
-    // Kaynak kodu ayrıştırır ve sözdizimi ağacını oluşturur
-    std::shared_ptr<ParseNode> parse() {
-        auto root = std::make_shared<ParseNode>(PROGRAM);
-        currentToken = getNextToken();
-        while (!currentToken.empty()) {
-            // Fonksiyon tanımı veya değişken tanımı
-            if (isType(currentToken)) {
-                std::string nextToken = getNextToken();
-                position -= nextToken.length();
-                if (nextToken == "(") {
-                    root->children.push_back(parseFunctionDef());
-                } else {
-                    root->children.push_back(parseVariableDecl());
-                }
-            }
-            // Diğer ifadeler
-            else if (currentToken != ";") {  
-                auto stmt = parseStatement();
-                if (stmt->type != EXPRESSION || !stmt->children.empty()) {
-                    root->children.push_back(stmt);
-                }
-            } else {
-                currentToken = getNextToken();
-            }
+void ParseTreeWindow::showResult() {
+    parser->readTree([this](const ParseTree& parseTree, unsigned long revision) {
+        if (hasShown && revision == shownRevision) return;
+        hasShown = true;
+        shownRevision = revision;
+        OlcumKapsami timer(OA_AGAC_ESITLE);
+        timer.say(OS_DUGUM, parseTree.nodeCount());
+        DisplayEntry root = {parseTree.root(), nullptr};
+        if (!programItem) {
+            tree->clear();
+            selectedItem = nullptr;
+            OlcumKapsami addTimer(OA_AGAC_EKLE);
+            addTimer.say(OS_OGE, addEntry(parseTree, tree->root(), root, -1));
+            programItem = tree->root()->child(0);
+        } else {
+            syncEntry(parseTree, programItem, root);
         }
-        return root;
-    }
-};
+        if (hasCursor && revision == akis->revizyon()) selectCursor(parseTree);
+        tree->redraw();
+        if (listener) listener(parseTree, revision, listenerData);
+    });
+}
 
-// Sözdizimi ağacı görselleştirme penceresi
-class ParseTreeWindow : public Fl_Window {
-private:
-    Fl_Tree* tree;              // Ağaç görünümü
-    Fl_Text_Buffer* buffer;     // Kaynak kod metni
-    bool isVisible;             // Pencere görünürlüğü
-    Parser* parser;             // Sözdizimi çözümleyici
-    static const char* getNodeTypeName(NodeType type) {
-        switch (type) {
-            case PROGRAM: return "Program";
-            case FUNCTION_DEF: return "Fonksiyon Tanımı";
-            case VARIABLE_DECL: return "Değişken Tanımı";
-            case PARAM_LIST: return "Parametre Listesi";
-            case PARAM: return "Parametre";
-            case STATEMENT: return "İfade";
-            case IF_STATEMENT: return "If İfadesi";
-            case WHILE_STATEMENT: return "While Döngüsü";
-            case FOR_STATEMENT: return "For Döngüsü";
-            case RETURN_STATEMENT: return "Return İfadesi";
-            case EXPRESSION: return "İfade";
-            case BINARY_EXPR: return "İkili İşlem";
-            case UNARY_EXPR: return "Tekli İşlem";
-            case ASSIGNMENT_EXPR: return "Atama İfadesi";
-            case LITERAL: return "Sabit Değer";
-            case IDENTIFIER: return "Tanımlayıcı";
-            case TYPE: return "Veri Tipi";
-            case BLOCK_STATEMENT: return "Kod Bloğu";
-            default: return "Bilinmeyen";
-        }
+void ParseTreeWindow::selectCursor(const ParseTree& parseTree) {
+    NodeId node = parseTree.root();
+    if (!programItem || node == NO_NODE || cursor >= parseTree.spanEnd(node)) return;
+    // Görünüm ağacın şeklini izler; yalnızca rol etiketleri araya bir öğe ekler
+    Fl_Tree_Item* item = programItem;
+    for (;;) {
+        uint32_t i = childIndexAt(parseTree, node, cursor);
+        if (i == parseTree.childCount(node) || (int)i >= item->children()) break;
+        item->open();
+        item = item->child((int)i);
+        if (childRole(parseTree.type(node), i)) {
+            item->open();
+            item = item->child(0);
+        }
+        node = parseTree.child(node, i);
     }
-    // Düğümü ağaca ekler
-    void addNodeToTree(Fl_Tree_Item* parent, const std::shared_ptr<ParseNode>& node) {
-        std::string label = getNodeTypeName(node->type);
-        switch (node->type) {
-            case IF_STATEMENT:
-                label = "If İfadesi";
-                if (!node->children.empty()) {
+    // Ağaç taranmaz; yalnızca önceki seçim kaldırılır
+    if (selectedItem != item) {
+        if (selectedItem) tree->deselect(selectedItem, 0);
+        tree->select(item, 0);
+        selectedItem = item;
+    }
+    tree->show_item_middle(item);
+}
 
-                    auto conditionNode = std::make_shared<ParseNode>(EXPRESSION, "Koşul");
-                    conditionNode->children.push_back(node->children[0]);
-                    node->children[0] = conditionNode;
+void ParseTreeWindow::jumpToSymbol(uint32_t offset, bool definition) {
+    hasJump = true;
+    jumpToDefinition = definition;
+    jumpOffset = offset;
+    jumpRevision = akis->revizyon();
+    symbolsWanted = true;
+    tryJump();
+    if (hasJump) updateTree();
+}
 
-                    if (node->children.size() > 1) {
-                        auto thenNode = std::make_shared<ParseNode>(BLOCK_STATEMENT, "Then Bloğu");
-                        thenNode->children.push_back(node->children[1]);
-                        node->children[1] = thenNode;
-                    }
+void ParseTreeWindow::tryJump() {
+    if (!hasJump) return;
+    // Belge istekten sonra değiştiyse istek geçersizdir
+    if (jumpRevision != akis->revizyon()) {
+        hasJump = false;
+        return;
+    }
+    bool found = false;
+    uint32_t target = 0;
+    parser->readSymbols([&](const ParseTree& parseTree, const SymbolIndex& symbols, unsigned long revision) {
+        // Daha eski bir ağacın konumları güncel metne uymaz; güncel sonuç gelince yeniden denenir
+        if (revision != jumpRevision) return;
+        hasJump = false;
+        NodeId node = nodeAt(parseTree, jumpOffset);
+        if (node == NO_NODE || parseTree.type(node) != IDENTIFIER) return;
+        std::string_view name = parseTree.value(node);
+        std::vector<SymbolLocation> locations;
+        if (jumpToDefinition) symbols.definitions(name, locations);
+        else symbols.uses(name, locations);
+        // Tanımlardan ilki; kullanımlardan adın bulunduğu yerden sonraki ilki, yoksa ilki
+        uint32_t first = UINT32_MAX, next = UINT32_MAX;
+        uint32_t here = parseTree.spanStart(node);
+        for (const SymbolLocation& location : locations) {
+            first = std::min(first, location.start);
+            if (location.start > here) next = std::min(next, location.start);
+        }
+        if (first == UINT32_MAX) return;
+        target = jumpToDefinition || next == UINT32_MAX ? first : next;
+        found = true;
+    });
+    if (found && jumpListener) jumpListener(target, jumpListenerData);
+}
 
-                    if (node->children.size() > 2) {
-                        auto elseNode = std::make_shared<ParseNode>(BLOCK_STATEMENT, "Else Bloğu");
-                        elseNode->children.push_back(node->children[2]);
-                        node->children[2] = elseNode;
-                    }
-                }
-                break;
-                
-            case WHILE_STATEMENT:
-                label = "While Döngüsü";
-                if (!node->children.empty()) {
+void ParseTreeWindow::showCursor(uint32_t offset) {
+    hasCursor = true;
+    cursor = offset;
+    if (!isVisible || !hasShown || shownRevision != akis->revizyon()) return;
+    parser->readTree([this](const ParseTree& parseTree, unsigned long revision) {
+        // Ağaç görünüme aktarılandan daha yeniyse öğeler henüz eşleşmez; sonuç gelince seçilir
+        if (revision != shownRevision) return;
+        selectCursor(parseTree);
+        tree->redraw();
+    });
+}
 
-                    auto conditionNode = std::make_shared<ParseNode>(EXPRESSION, "Koşul");
-                    conditionNode->children.push_back(node->children[0]);
-                    node->children[0] = conditionNode;
+ParseTreeWindow::ParseTreeWindow(int w, int h, const char* title, TokenAkisi* tokenAkisi)
+    : Fl_Window(w, h, title), akis(tokenAkisi), isVisible(false),
+      hasShown(false), programItem(nullptr), selectedItem(nullptr), shownRevision(0), hasRequest(false),
+      requestedRevision(0), debounce(0.25), listener(nullptr), listenerData(nullptr), hasCursor(false), cursor(0),
+      jumpListener(nullptr), jumpListenerData(nullptr), symbolsWanted(false), hasJump(false), jumpToDefinition(false),
+      jumpOffset(0), jumpRevision(0) {
+    tree = new Fl_Tree(10, 10, w-20, h-20);
+    tree->showroot(0);                    // Kök düğümü gizle
+    tree->connectorstyle(FL_TREE_CONNECTOR_DOTTED);  // Noktalı bağlantı çizgileri
+    tree->selectmode(FL_TREE_SELECT_NONE);  // Seçimi devre dışı bırak
+    parser = new BackgroundParser(parse_ready_cb, this);  // Çözümleyiciyi oluştur
+    end();
+}
 
-                    if (node->children.size() > 1) {
-                        auto bodyNode = std::make_shared<ParseNode>(BLOCK_STATEMENT, "Döngü Gövdesi");
-                        bodyNode->children.push_back(node->children[1]);
-                        node->children[1] = bodyNode;
-                    }
-                }
-                break;
-                
-            case FOR_STATEMENT:
-                label = "For Döngüsü";
-                if (!node->children.empty()) {
+ParseTreeWindow::~ParseTreeWindow() {
+    Fl::remove_timeout(debounce_cb, this);
+    delete parser;  // Çözümleyici iş parçacığını durdur
+}
 
-                    auto initNode = std::make_shared<ParseNode>(EXPRESSION, "Başlangıç");
-                    initNode->children.push_back(node->children[0]);
-                    node->children[0] = initNode;
+void ParseTreeWindow::scheduleUpdate() {
+    if (!isVisible && !symbolsWanted) return;
+    Fl::remove_timeout(debounce_cb, this);
+    Fl::add_timeout(debounce, debounce_cb, this);
+}
 
-                    if (node->children.size() > 1) {
-                        auto conditionNode = std::make_shared<ParseNode>(EXPRESSION, "Koşul");
-                        conditionNode->children.push_back(node->children[1]);
-                        node->children[1] = conditionNode;
-                    }
+void ParseTreeWindow::updateTree() {
+    if (!isVisible && !symbolsWanted) return;
+    Fl::remove_timeout(debounce_cb, this);
+    if (hasRequest && requestedRevision == akis->revizyon()) return;
+    // Akışın sonu henüz boşta lexleniyorsa ayrıştırma biraz sonraya kalır
+    if (!akis->tamamlandi()) {
+        Fl::add_timeout(debounce, debounce_cb, this);
+        return;
+    }
+    // Önceki istekten bu yana değişen aralık biliniyorsa yalnızca o kısım yeniden ayrıştırılır
+    DegisimAraligi edit;
+    bool incremental = hasRequest && akis->degisimlerSonra(requestedRevision, edit);
+    hasRequest = true;
+    requestedRevision = akis->revizyon();
+    parser->request(akis->goruntu(), akis->getTokenlar(), requestedRevision, incremental ? &edit : nullptr);
+}
 
-                    if (node->children.size() > 2) {
-                        auto incrementNode = std::make_shared<ParseNode>(EXPRESSION, "Artırma");
-                        incrementNode->children.push_back(node->children[2]);
-                        node->children[2] = incrementNode;
-                    }
+void ParseTreeWindow::seedTree(const ParseTreeImage& image) {
+    Fl::remove_timeout(debounce_cb, this);
+    // Ağaç bütün metnin token'larından kurulmuştur
+    akis->tamamla();
+    hasRequest = true;
+    requestedRevision = akis->revizyon();
+    parser->seed(akis->goruntu(), akis->getTokenlar(), requestedRevision, image);
+    if (isVisible) showResult();
+}
 
-                    if (node->children.size() > 3) {
-                        auto bodyNode = std::make_shared<ParseNode>(BLOCK_STATEMENT, "Döngü Gövdesi");
-                        bodyNode->children.push_back(node->children[3]);
-                        node->children[3] = bodyNode;
-                    }
-                }
-                break;
-                
-            default:
-                if (!node->value.empty()) {
-                    label += ": " + node->value;
-                }
-                break;
-        }
-        
-        Fl_Tree_Item* item = tree->add(parent, label.c_str());
-        item->open(); 
-        
-        for (const auto& child : node->children) {
-            addNodeToTree(item, child);
-        }
-    }
+void ParseTreeWindow::show() {
+    isVisible = true;
+    Fl_Window::show();
+    updateTree();
+    // Yüklenmiş veya pencere kapalıyken hazırlanmış bir ağaç varsa hemen görüntülenir
+    showResult();
+}
 
-public:
-    // Yapıcı fonksiyon
-    ParseTreeWindow(int w, int h, const char* title, Fl_Text_Buffer* buf)
-        : Fl_Window(w, h, "Sözdizimi Ağacı"), buffer(buf), isVisible(false) {
-        tree = new Fl_Tree(10, 10, w-20, h-20);
-        tree->showroot(0);                    // Kök düğümü gizle
-        tree->connectorstyle(FL_TREE_CONNECTOR_DOTTED);  // Noktalı bağlantı çizgileri
-        tree->selectmode(FL_TREE_SELECT_NONE);  // Seçimi devre dışı bırak
-        parser = new Parser(buffer);          // Çözümleyiciyi oluştur
-        end();
-    }
-    // Yıkıcı fonksiyon
-    ~ParseTreeWindow() {
-        delete parser;  // Çözümleyiciyi temizle
-    }
-    // Ağacı günceller
-    void updateTree() {
-        if (!isVisible) return;
-        tree->clear();
-        parser->position = 0;  // Çözümleyici konumunu sıfırla
-        auto root = parser->parse();
-        Fl_Tree_Item* rootItem = tree->add("Program");
-        rootItem->open();
-        for (const auto& child : root->children) {
-            addNodeToTree(rootItem, child);
-        }
-        tree->redraw();
-    }
-    // Pencereyi göster
-    void show() {
-        isVisible = true;
-        Fl_Window::show();
-        updateTree();
-    }
-    // Pencereyi gizle
-    void hide() {
-        isVisible = false;
-        Fl_Window::hide();
-    }
-};
+void ParseTreeWindow::hide() {
+    isVisible = false;
+    // Ada gitme kullanıldıysa ağaç kapalıyken de güncellenmeye devam eder
+    if (!symbolsWanted) Fl::remove_timeout(debounce_cb, this);
+    Fl_Window::hide();
+}
 
 // Metin değiştiğinde çağrılan callback
 void metin_degisti_parse_cb(int pos, int nInserted, int nDeleted, int, const char*, void* v) {
     if (nInserted || nDeleted) {
         ParseTreeWindow* window = static_cast<ParseTreeWindow*>(v);
-        window->updateTree();
+        window->scheduleUpdate();
     }
 }
 
@@ -654,4 +445,4 @@ void metin_degisti_parse_cb(int pos, int nInserted, int nDeleted, int, const cha
 void parse_tree_cb(Fl_Widget*, void* v) {
     ParseTreeWindow* window = static_cast<ParseTreeWindow*>(v);
     window->show();
-} 
+}
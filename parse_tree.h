@@ -0,0 +1,239 @@
+#ifndef PARSE_TREE_H
+#define PARSE_TREE_H
+
+#include <FL/Fl.H>
+#include <FL/Fl_Window.H>
+#include <FL/Fl_Tree.H>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+#include "belge.h"
+#include "parser.h"
+#include "symbol_index.h"
+
+// Arka planda ayrıştırılacak belge anlık görüntüsü
+// Artımlı isteklerde yalnızca değişen aralığın token'ları kopyalanır; metin
+// iş parçacığında görüntünün o aralığından okunur
+struct ParseSnapshot {
+    BelgeGoruntusu document;     // Belgenin değişmez görüntüsü
+    TokenDeposu tokenStore;      // Baştan ayrıştırmada bütün token'ların sıkı kopyası
+    std::vector<Token> changed;  // Artımlı istekte edit aralığının yeni token'ları
+    bool incremental;            // edit geçerli mi (değilse baştan ayrıştırılır)
+    DegisimAraligi edit;         // Önceki istekten bu yana token'ları değişen aralık
+    unsigned long revision;      // Görüntünün alındığı belge revizyonu
+    unsigned long generation;    // İsteğin nesli
+
+    ParseSnapshot() : incremental(false), edit{0, 0, 0}, revision(0), generation(0) {}
+};
+
+// Sözdizimi ağacını ayrı bir iş parçacığında oluşturan çözümleyici
+// Her istek yeni bir nesil numarası alır; daha yeni bir istek geldiğinde
+// bekleyen istek atılır, süren ayrıştırma iptal edilir. Ağaç iş parçacığında
+// kalıcıdır ve her istekte yalnızca değişen üst düzey öğeleri yeniden
+// ayrıştırılır. Tamamlanan sonuç Fl::awake ile arayüz iş parçacığına bildirilir.
+class BackgroundParser {
+private:
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::atomic<unsigned long> generation;  // En son isteğin nesli
+    std::unique_ptr<ParseSnapshot> pending; // İstenmiş, henüz başlanmamış iş
+    std::unique_ptr<ParseSnapshot> spare;   // Belleği yeniden kullanılacak görüntü
+    bool stopping;
+    Fl_Awake_Handler onReady;               // Sonuç hazır olduğunda çağrılır
+    void* onReadyData;
+
+    // Aşağıdakiler ayrıştırma süresince treeMutex ile korunur
+    std::mutex treeMutex;
+    ParseTree tree;                         // Kalıcı sözdizimi ağacı
+    SymbolIndex symbols;                    // Ağacın tanım/kullanım dizini; ağaçla birlikte güncellenir
+    // Parser bitişik metin ve mutlak konumlu düz token'lar okur; iş parçacığı
+    // bunları istekten isteğe kendi kopyalarında düzenleme aralığıyla günceller
+    std::string text;                       // Son alınan isteğin metni; ağacın değerleri buna işaret eder
+    std::vector<Token> tokens;              // Son alınan isteğin token'ları
+    unsigned long treeRevision;             // Ağacın ayrıştırıldığı belge revizyonu
+    unsigned long seedGeneration;           // seed()'in nesli; daha eski istekler 'text'e uygulanmaz
+    bool treeValid;                         // Ağaç artımlı ayrıştırmaya temel olabilir mi
+    bool treeCurrent;                       // Ağaç 'text'e göre tam mı (iptal edilen istek metni ilerletmiş olabilir)
+    bool hasUnparsedEdit;                   // İptal edilen isteklerin düzenlemeleri bekliyor mu
+    DegisimAraligi unparsedEdit;            // Ağacın metninden son iptal edilen isteğe kadar olan aralık
+
+    std::thread worker;
+
+    // Kullanılmayan bir görüntüyü yeniden kullanmak üzere saklar
+    // Kilit altında çağrılmalıdır
+    void recycle(std::unique_ptr<ParseSnapshot> snapshot) {
+        if (!spare) spare = std::move(snapshot);
+    }
+
+    // 'text' ve 'tokens'ı isteğin revizyonuna getirir
+    // Artımlı istekte yalnızca aralık yeniden okunur; sonrası kaydırılır
+    void follow(const ParseSnapshot& job);
+    // Görüntüyü ağaca uygular; iptal edilmeden biterse true döndürür
+    bool apply(Parser& parser, const ParseSnapshot& job);
+    void run();
+
+public:
+    BackgroundParser(Fl_Awake_Handler handler, void* data);
+    ~BackgroundParser();
+    // Belgenin görüntüsünü ayrıştırılmak üzere kuyruğa koyar
+    // Görüntüyü almak ucuzdur; metin arayüz iş parçacığında kopyalanmaz.
+    // edit, önceki istekten bu yana token'ları değişen aralıktır ve yalnızca
+    // o aralığın token'ları kopyalanır; nullptr ise bütün token'lar kopyalanır
+    // ve ağaç baştan kurulur. Önceki istekler geçersiz olur.
+    void request(const BelgeGoruntusu& document, const TokenDeposu& tokenStore, unsigned long revision,
+                 const DegisimAraligi* edit);
+    // Ağacı ayrıştırmadan, aynı metinden daha önce kurulmuş bir ağacın
+    // kopyasıyla (ör. önbellekten) değiştirir; sonraki istekler bu ağaçtan
+    // artımlı olarak devam eder
+    void seed(const BelgeGoruntusu& document, const TokenDeposu& tokenStore, unsigned long revision,
+              const ParseTreeImage& image);
+    // Ağaç şu anda ayrıştırılmıyorsa 'f(tree, revision)' çağırıp true döndürür
+    // Arayüz iş parçacığını bekletmemek için kilit yalnızca denenir; başarısız
+    // olursa daha yeni bir sonuç hazırlanıyordur ve ayrıca bildirilecektir
+    template <typename F>
+    bool readTree(F&& f) {
+        std::unique_lock<std::mutex> treeLock(treeMutex, std::try_to_lock);
+        if (!treeLock.owns_lock() || !treeCurrent) return false;
+        f(static_cast<const ParseTree&>(tree), treeRevision);
+        return true;
+    }
+    // readTree gibi; 'f(tree, symbols, revision)' ağacın tanım/kullanım diziniyle çağrılır
+    template <typename F>
+    bool readSymbols(F&& f) {
+        std::unique_lock<std::mutex> treeLock(treeMutex, std::try_to_lock);
+        if (!treeLock.owns_lock() || !treeCurrent) return false;
+        f(static_cast<const ParseTree&>(tree), static_cast<const SymbolIndex&>(symbols), treeRevision);
+        return true;
+    }
+};
+
+// Görünüme aktarılan her yeni ağaç için arayüz iş parçacığında çağrılır
+typedef void (*TreeListener)(const ParseTree& tree, unsigned long revision, void* data);
+// Bir ada gidilecekken arayüz iş parçacığında çağrılır; 'offset' adın metindeki başlangıcıdır
+typedef void (*JumpListener)(uint32_t offset, void* data);
+
+// Sözdizimi ağacı görselleştirme penceresi
+class ParseTreeWindow : public Fl_Window {
+private:
+    Fl_Tree* tree;              // Ağaç görünümü
+    TokenAkisi* akis;           // Belgenin paylaşılan token akışı
+    bool isVisible;             // Pencere görünürlüğü
+    BackgroundParser* parser;   // Arka plan sözdizimi çözümleyicisi
+    bool hasShown;              // Ağaç görünümü en az bir kez dolduruldu mu
+    Fl_Tree_Item* programItem;  // Görünümdeki "Program" öğesi
+    Fl_Tree_Item* selectedItem; // İmleç için seçilen öğe (nullptr: yok)
+    unsigned long shownRevision;  // Görüntülenen ağacın belge revizyonu
+    bool hasRequest;            // En az bir ayrıştırma istendi mi
+    unsigned long requestedRevision;  // Son istenen belge revizyonu
+    double debounce;            // Son düzenlemeden sonra ayrıştırmadan önce beklenecek süre (saniye)
+    TreeListener listener;      // Yeni ağaç görüntülendiğinde çağrılır (nullptr: yok)
+    void* listenerData;
+    bool hasCursor;             // Düzenleyicinin imleci biliniyor mu
+    uint32_t cursor;            // İmlecin metindeki konumu
+    JumpListener jumpListener;  // Ada gidilecekken çağrılır (nullptr: yok)
+    void* jumpListenerData;
+    bool symbolsWanted;         // Ada gitme kullanıldı; ağaç pencere kapalıyken de güncel tutulur
+    bool hasJump;               // Güncel ağacı bekleyen bir ada gitme isteği var mı
+    bool jumpToDefinition;      // İstek tanıma mı, sonraki kullanıma mı
+    uint32_t jumpOffset;        // İsteğin yapıldığı imleç konumu
+    unsigned long jumpRevision; // İsteğin yapıldığı belge revizyonu
+
+    // Görünümdeki bir öğe: bir düğüm ya da düğümü saran bir rol etiketi
+    struct DisplayEntry {
+        NodeId node;        // Gösterilen düğüm
+        const char* role;   // Rol etiketi (nullptr: düğümün kendisi)
+    };
+    static std::string entryLabel(const ParseTree& parseTree, const DisplayEntry& entry);
+    static uint64_t entryHash(const ParseTree& parseTree, const DisplayEntry& entry);
+    static uint32_t entryChildCount(const ParseTree& parseTree, const DisplayEntry& entry) {
+        return entry.role ? 1 : parseTree.childCount(entry.node);
+    }
+    static DisplayEntry entryChild(const ParseTree& parseTree, const DisplayEntry& entry, uint32_t i) {
+        if (entry.role) return DisplayEntry{entry.node, nullptr};
+        return DisplayEntry{parseTree.child(entry.node, i), childRole(parseTree.type(entry.node), i)};
+    }
+    // Öğenin gösterdiği alt ağacın özeti user_data içinde saklanır
+    static uint64_t itemHash(Fl_Tree_Item* item) {
+        return (uint64_t)reinterpret_cast<uintptr_t>(item->user_data());
+    }
+
+    // Öğeyi ve bütün alt öğelerini oluşturur; pos < 0 ise sona ekler
+    // Eklenen öğe sayısını döndürür
+    size_t addEntry(const ParseTree& parseTree, Fl_Tree_Item* parent, const DisplayEntry& entry, int pos);
+    // Öğeyi alt öğeleriyle siler; seçili öğe aralarındaysa unutulur
+    void removeItem(Fl_Tree_Item* item);
+    // Mevcut öğeyi yeni ağaca göre günceller
+    // Özeti aynı olan alt ağaçlara dokunulmaz; öğeler silinmediği için açık/kapalı durumları korunur
+    void syncEntry(const ParseTree& parseTree, Fl_Tree_Item* item, const DisplayEntry& entry);
+
+    // Düzenlemeler durulunca ayrıştırmayı başlatır
+    static void debounce_cb(void* v) {
+        static_cast<ParseTreeWindow*>(v)->updateTree();
+    }
+    // Arka plan ayrıştırması bittiğinde arayüz iş parçacığında çağrılır
+    static void parse_ready_cb(void* v) {
+        ParseTreeWindow* window = static_cast<ParseTreeWindow*>(v);
+        if (window->isVisible) window->showResult();
+        window->tryJump();
+    }
+    // Hazır sonucu ağaç görünümüne aktarır
+    // İlk seferden sonra yalnızca değişen alt ağaçların öğeleri eklenir veya silinir
+    void showResult();
+    // İmleci kapsayan en içteki düğümün öğesini seçer
+    // Görünüm 'parseTree'nin öğeleriyle eşitlenmiş olmalıdır
+    void selectCursor(const ParseTree& parseTree);
+    // Bekleyen ada gitme isteğini ağaç isteğin revizyonundaysa yerine getirir
+    void tryJump();
+
+public:
+    // Yapıcı fonksiyon
+    ParseTreeWindow(int w, int h, const char* title, TokenAkisi* tokenAkisi);
+    // Yıkıcı fonksiyon
+    ~ParseTreeWindow();
+    // Düzenleme ile ayrıştırma arasındaki bekleme süresini ayarlar (saniye)
+    void setDebounce(double seconds) { debounce = seconds; }
+    double getDebounce() const { return debounce; }
+    // Ayrıştırmayı son düzenlemeden 'debounce' saniye sonraya erteler
+    // Art arda gelen düzenlemeler tek bir ayrıştırmaya dönüşür
+    void scheduleUpdate();
+    // Belgenin güncel halini arka planda ayrıştırmak üzere ister
+    // Belge son istekten beri değişmediyse hiçbir şey yapmaz
+    void updateTree();
+    // Belgenin güncel revizyonunun ağacını ayrıştırmadan yükler
+    // Pencere açıldığında ağaç beklemeden görüntülenir
+    void seedTree(const ParseTreeImage& image);
+    // Görünüme aktarılan ağaçları dinler (ör. önbelleğe yazmak için)
+    void setTreeListener(TreeListener f, void* data) {
+        listener = f;
+        listenerData = data;
+    }
+    // Düzenleyicinin imlecini izler; görüntülenen ağaç belgenin güncel
+    // revizyonundaysa imleci kapsayan en içteki düğüm seçilir, değilse
+    // seçim bir sonraki ağaç görüntülendiğinde yapılır
+    void showCursor(uint32_t offset);
+    // 'offset'teki adın tanımına (definition) veya imleçten sonraki kullanımına
+    // (sonuncusundaysa ilkine) gider. Ad çapraz başvuru dizininde aranır;
+    // ağaç güncel değilse ayrıştırma istenir ve gidiş sonuç gelince yapılır.
+    void jumpToSymbol(uint32_t offset, bool definition);
+    void setJumpListener(JumpListener f, void* data) {
+        jumpListener = f;
+        jumpListenerData = data;
+    }
+    // Pencereyi göster
+    void show();
+    // Pencereyi gizle
+    void hide();
+};
+
+// Metin değiştiğinde çağrılan callback
+void metin_degisti_parse_cb(int pos, int nInserted, int nDeleted, int, const char*, void* v);
+// Sözdizimi ağacını gösteren callback
+void parse_tree_cb(Fl_Widget*, void* v);
+
+#endif
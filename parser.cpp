@@ -0,0 +1,1011 @@
+#include "parser.h"
+#include "anahtar_kelimeler.h"
+#include <algorithm>
+#include <cctype>
+
+// Token'ın bir veri tipi olup olmadığını kontrol eder
+bool Parser::isType(std::string_view token) {
+    return (kelimeTuru(token) & KT_TIP) != 0;
+}
+
+// Token'ın bir anahtar kelime olup olmadığını kontrol eder
+bool Parser::isKeyword(std::string_view token) {
+    return (kelimeTuru(token) & KT_DEYIM) != 0;
+}
+
+namespace {
+
+// C operatör tablosu
+// İfade ayrıştırıcısı operatör konumundaki bir token'ı bu tabloda bir kez
+// arar ve ne yapacağını kaydın rolünden okur. İkili öncelik ve önek/sonek
+// kullanımı da buradadır; tabloda olmayan token ifadeyi bitirir.
+enum OperatorRole : uint8_t {
+    ROLE_OPERATOR,  // İkili, önek veya sonek operatör
+    ROLE_CALL,      // '(' operanddan sonra çağrı açar
+    ROLE_INDEX,     // '['
+    ROLE_MEMBER,    // '.' ve '->'
+    ROLE_CLOSE,     // ')' ve ']'
+    ROLE_COMMA,     // ','
+    ROLE_QUESTION,  // '?'
+    ROLE_COLON      // ':'
+};
+
+struct OperatorInfo {
+    const char* text;
+    OperatorRole role;
+    uint8_t binary;  // İkili operatör önceliği (PREC_NONE: ikili değil)
+    bool prefix;     // Önek olarak kullanılabilir (-a, !a, *p, ++i)
+    bool postfix;    // Sonek olarak kullanılabilir (i++)
+};
+
+typedef Parser::Precedence P;
+const OperatorInfo OPERATORS[] = {
+    // İlk karakterine göre gruplu olmalı
+    {"!", ROLE_OPERATOR, 0, true, false},
+    {"!=", ROLE_OPERATOR, P::PREC_EQUALITY, false, false},
+    {"%", ROLE_OPERATOR, P::PREC_MULTIPLICATIVE, false, false},
+    {"%=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"&", ROLE_OPERATOR, P::PREC_BIT_AND, true, false},
+    {"&&", ROLE_OPERATOR, P::PREC_LOGICAL_AND, false, false},
+    {"&=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"(", ROLE_CALL, 0, false, false},
+    {")", ROLE_CLOSE, 0, false, false},
+    {"*", ROLE_OPERATOR, P::PREC_MULTIPLICATIVE, true, false},
+    {"*=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"+", ROLE_OPERATOR, P::PREC_ADDITIVE, true, false},
+    {"++", ROLE_OPERATOR, 0, true, true},
+    {"+=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {",", ROLE_COMMA, P::PREC_COMMA, false, false},
+    {"-", ROLE_OPERATOR, P::PREC_ADDITIVE, true, false},
+    {"--", ROLE_OPERATOR, 0, true, true},
+    {"-=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"->", ROLE_MEMBER, 0, false, false},
+    {".", ROLE_MEMBER, 0, false, false},
+    {"/", ROLE_OPERATOR, P::PREC_MULTIPLICATIVE, false, false},
+    {"/=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {":", ROLE_COLON, 0, false, false},
+    {"<", ROLE_OPERATOR, P::PREC_RELATIONAL, false, false},
+    {"<<", ROLE_OPERATOR, P::PREC_SHIFT, false, false},
+    {"<<=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"<=", ROLE_OPERATOR, P::PREC_RELATIONAL, false, false},
+    {"=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"==", ROLE_OPERATOR, P::PREC_EQUALITY, false, false},
+    {">", ROLE_OPERATOR, P::PREC_RELATIONAL, false, false},
+    {">=", ROLE_OPERATOR, P::PREC_RELATIONAL, false, false},
+    {">>", ROLE_OPERATOR, P::PREC_SHIFT, false, false},
+    {">>=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"?", ROLE_QUESTION, P::PREC_CONDITIONAL, false, false},
+    {"[", ROLE_INDEX, 0, false, false},
+    {"]", ROLE_CLOSE, 0, false, false},
+    {"^", ROLE_OPERATOR, P::PREC_BIT_XOR, false, false},
+    {"^=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"|", ROLE_OPERATOR, P::PREC_BIT_OR, false, false},
+    {"|=", ROLE_OPERATOR, P::PREC_ASSIGN, false, false},
+    {"||", ROLE_OPERATOR, P::PREC_LOGICAL_OR, false, false},
+    {"~", ROLE_OPERATOR, 0, true, false},
+};
+
+// İlk karaktere göre dizin; arama o karakterle başlayan birkaç kayda bakar
+struct OperatorIndex {
+    uint8_t first[256];  // İlk karakteri c olan ilk kaydın yeri
+    uint8_t count[256];  // İlk karakteri c olan kayıt sayısı
+    bool extends[256];   // c ile başlayan çok karakterli bir operatör var mı
+    OperatorIndex() {
+        for (int c = 0; c < 256; ++c) {
+            first[c] = count[c] = 0;
+            extends[c] = false;
+        }
+        for (int i = (int)(sizeof(OPERATORS) / sizeof(OPERATORS[0])) - 1; i >= 0; --i) {
+            unsigned char c = (unsigned char)OPERATORS[i].text[0];
+            first[c] = (uint8_t)i;
+            ++count[c];
+            if (OPERATORS[i].text[1]) extends[c] = true;
+        }
+    }
+};
+const OperatorIndex operatorIndex;
+
+const OperatorInfo* findOperator(std::string_view token) {
+    if (token.empty() || token.size() > 3) return nullptr;
+    unsigned char c = (unsigned char)token[0];
+    for (int i = operatorIndex.first[c], end = i + operatorIndex.count[c]; i < end; ++i) {
+        if (token == OPERATORS[i].text) return &OPERATORS[i];
+    }
+    return nullptr;
+}
+
+// Atama ve üçlü işlem sağdan, diğer ikili operatörler soldan birleşir
+bool rightAssociative(int precedence) {
+    return precedence == Parser::PREC_ASSIGN || precedence == Parser::PREC_CONDITIONAL ||
+           precedence == Parser::PREC_UNARY;
+}
+
+// Operand beklenirken görülünce tüketilmeyen token'lar; eksik operand
+// boş bir ifadeyle doldurulur ve token'ı çevreleyen yapı işler
+bool closesExpression(std::string_view token) {
+    return token == ")" || token == "]" || token == "}" || token == "{" || token == ";" || token == "," ||
+           token == ":";
+}
+
+} // namespace
+
+// Alt ağaç özetine bir değer katar
+static uint64_t mixHash(uint64_t h, uint64_t v) {
+    h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    return h * 0xFF51AFD7ED558CCDull;
+}
+
+// 'from' işaretinden sonra eklenen alt düğümlerle yeni bir düğüm oluşturur
+NodeId Parser::finishNode(NodeType type, size_t from, uint32_t start, std::string_view value) {
+    ParseNode node;
+    node.type = type;
+    node.segment = segment;
+    node.valueStart = value.empty() ? 0 : offsetOf(value) - segmentStart;
+    node.valueLength = (uint32_t)value.size();
+    // Yapraklar değerlerini tüketmeden önce oluşturulur; kapsam değeri de içerir
+    uint32_t end = std::max(consumedEnd, start);
+    if (!value.empty()) {
+        end = std::max(end, offsetOf(value) + (uint32_t)value.size());
+    } else if (consumedEnd <= start) {
+        // Hiç token tüketmeyen (metin sonunda kalan) düğüm son token'ın hemen ardında durur
+        start = end = std::max(consumedEnd, segmentStart);
+    }
+    node.spanStart = start - segmentStart;
+    node.spanLength = end - start;
+    node.firstChild = (uint32_t)tree->childIds.size();
+    node.childCount = (uint32_t)(pending.size() - from);
+    // Özet, alt düğümler önceden oluşturulduğu için burada bir kez hesaplanır
+    uint64_t h = mixHash(0xCBF29CE484222325ull, (uint64_t)type);
+    for (char c : value) h = mixHash(h, (unsigned char)c);
+    for (size_t i = from; i < pending.size(); ++i) h = mixHash(h, tree->nodes[pending[i]].hash);
+    node.hash = h;
+    tree->childIds.insert(tree->childIds.end(), pending.begin() + from, pending.end());
+    pending.resize(from);
+    tree->nodes.push_back(node);
+    return (NodeId)(tree->nodes.size() - 1);
+}
+
+// Alt düğümü olmayan bir düğüm oluşturur
+NodeId Parser::leafNode(NodeType type, std::string_view value) {
+    return finishNode(type, mark(), value.empty() ? currentStart() : offsetOf(value), value);
+}
+
+// Yalnızca lexer'ın tanımlayıcı saydığı token'lar kaydedilir; hatalı kodda
+// ad yerinde kalan ';' veya anahtar kelimeler düğüm olur ama ad sayılmaz.
+// 'token' az önce okunan token'dır: tanımlayıcılar birleştirilmediği için
+// tokens[tokenIndex - 1]'dedir ve tipi yeniden aranmaz.
+NodeId Parser::symbolNode(std::string_view token, SymbolRole role) {
+    NodeId node = leafNode(IDENTIFIER, token);
+    if (!token.empty() && (*tokens)[tokenIndex - 1].tip == TANIMLAYICI) {
+        tree->symbolRefs.push_back(SymbolRef{node, role});
+    }
+    return node;
+}
+
+// Bir sonraki token'ı alır
+// Yorumları atlar ve bir sonraki anlamlı token'ı döndürür
+// Dönen token kopya değil, metin üzerinde bir görünümdür
+std::string_view Parser::getNextToken() {
+    // Daha yeni bir istek geldiyse token akışını bitmiş gibi göster;
+    // bütün döngüler boş token'da durduğu için ayrıştırma hemen sona erer
+    if (cancelCounter && ++cancelCheck == CANCEL_CHECK_INTERVAL) {
+        cancelCheck = 0;
+        if (cancelCounter->load(std::memory_order_relaxed) != parseGeneration) {
+            wasCancelled = true;
+            tokenIndex = tokens->size();
+        }
+    }
+    // Şu anki token tüketilmiş olur
+    if (!currentToken.empty()) {
+        consumedStart = offsetOf(currentToken);
+        consumedEnd = consumedStart + (uint32_t)currentToken.size();
+    }
+    while (tokenIndex < tokens->size() && (*tokens)[tokenIndex].tip == YORUM) {
+        tokenIndex++;
+    }
+    if (tokenIndex >= tokens->size()) {
+        return std::string_view();
+    }
+    // Çoğu token birleştirilemez; birleştirme denemesi yalnızca operatör karakterlerinde yapılır
+    const Token& token = (*tokens)[tokenIndex];
+    if ((token.tip != OPERATOR && token.tip != NOKTALAMA) || token.bitis - token.baslangic != 1 ||
+        !operatorIndex.extends[(unsigned char)text[token.baslangic]]) {
+        ++tokenIndex;
+        return std::string_view(text.data() + token.baslangic, token.bitis - token.baslangic);
+    }
+    return readToken(tokenIndex);
+}
+
+// Sıradaki token'lardan birini tüketmeden döndürür
+// ahead = 0, getNextToken()'ın döndüreceği token'dır
+// Bakılan token'lar öğenin kararını etkiler; en uzak konum öğeye kaydedilir
+std::string_view Parser::peekToken(size_t ahead) {
+    for (size_t i = tokenIndex; i < tokens->size();) {
+        if ((*tokens)[i].tip == YORUM) {
+            ++i;
+            continue;
+        }
+        std::string_view token = readToken(i);
+        if (ahead-- == 0) {
+            // Bitişik bir karakter operatörü uzatabilir; o karakter de bakılmış sayılır
+            uint32_t end = offsetOf(token) + (uint32_t)token.size() + (findOperator(token) ? 1 : 0);
+            peekEnd = std::max(peekEnd, end);
+            return token;
+        }
+    }
+    peekEnd = END_OF_TEXT;
+    return std::string_view();
+}
+
+// Lexer operatör karakterlerini tek karakterlik token'lar olarak verir;
+// arada boşluk olmadan gelen karakterler birlikte bir C operatörü
+// oluşturuyorsa (ör. '&&', '!=', '<<=', '->') en uzun eşleşme tek token'dır
+std::string_view Parser::readToken(size_t& index) const {
+    const Token& token = (*tokens)[index++];
+    std::string_view view = text.substr(token.baslangic, token.bitis - token.baslangic);
+    if (view.size() != 1 || !operatorIndex.extends[(unsigned char)view[0]]) {
+        return view;
+    }
+    while (index < tokens->size()) {
+        const Token& next = (*tokens)[index];
+        if (next.bitis - next.baslangic != 1 || next.baslangic != token.baslangic + (int)view.size()) break;
+        std::string_view longer(view.data(), view.size() + 1);
+        if (!findOperator(longer)) break;
+        view = longer;
+        ++index;
+    }
+    return view;
+}
+
+// Yığının tepesindeki operatörü indirger
+void Parser::reduceOperator() {
+    ExprOp op = operators.back();
+    operators.pop_back();
+    switch (op.kind) {
+        case OP_BINARY: {
+            size_t from = pending.size() - 2;
+            addChild(finishNode(op.type, from, nodeStart(pending[from]), op.text));
+            break;
+        }
+        case OP_PREFIX:
+            addChild(finishNode(UNARY_EXPR, pending.size() - 1, op.start, op.text));
+            break;
+        case OP_CAST:
+            addChild(finishNode(CAST_EXPR, pending.size() - 2, op.start));
+            break;
+        case OP_CONDITIONAL: {
+            size_t from = pending.size() - 3;
+            addChild(finishNode(CONDITIONAL_EXPR, from, nodeStart(pending[from])));
+            break;
+        }
+        // Kapanmadan biten gruplar; kapsam son tüketilen token'da biter
+        case OP_PAREN:
+            break;
+        case OP_CALL:
+        case OP_INDEX:
+            addChild(finishNode(op.type, op.from, op.start));
+            break;
+        case OP_QUESTION: {
+            // ':' ve yanlış dalı eksik
+            addChild(leafNode(EXPRESSION));
+            size_t from = pending.size() - 3;
+            addChild(finishNode(CONDITIONAL_EXPR, from, nodeStart(pending[from])));
+            break;
+        }
+    }
+}
+
+// Tepedeki grubu kapanış token'ıyla birlikte bitirir
+void Parser::closeGroup() {
+    ExprOp op = operators.back();
+    operators.pop_back();
+    if (op.kind == OP_PAREN) {
+        // Parantezli ifadenin düğümü parantezleri de kapsar
+        ParseNode& node = tree->nodes[pending.back()];
+        node.spanStart = op.start - segmentStart;
+        node.spanLength = consumedEnd - op.start;
+    } else {
+        addChild(finishNode(op.type, op.from, op.start));
+    }
+}
+
+// İfadeleri operatör önceliğine göre ayrıştırır
+// Özyinelemesiz, tabloya dayalı bir öncelik ayrıştırıcısıdır: operandlar
+// 'pending' üzerinde, operatörler ve açık gruplar 'operators' yığınında
+// birikir. Bir operatör, kendisinden sıkı bağlanan operatörleri indirgedikten
+// sonra yığına girer. Her token bir kez okunur ve her operatör bir kez
+// indirgenir; süre token sayısıyla doğrusaldır ve iç içe parantezler C++
+// çağrı yığınını büyütmez.
+NodeId Parser::parseExpression(int minPrecedence) {
+    const size_t base = operators.size();
+    size_t groups = 0;  // Açık grup sayısı; grupların içinde her operatör geçerlidir
+    bool expectOperand = true;
+    for (;;) {
+        std::string_view token = currentToken;
+        if (expectOperand) {
+            // Metnin sonu
+            if (token.empty()) {
+                addChild(leafNode(EXPRESSION));
+                expectOperand = false;
+                continue;
+            }
+            // Tanımlayıcı (değişken/fonksiyon adı)
+            if (isalpha((unsigned char)token[0]) || token[0] == '_') {
+                if (token == "sizeof") {
+                    operators.push_back({OP_PREFIX, PREC_UNARY, UNARY_EXPR, token, currentStart(), 0});
+                } else {
+                    addChild(symbolNode(token, SYMBOL_USE));
+                    expectOperand = false;
+                }
+                currentToken = getNextToken();
+                continue;
+            }
+            // Sabit değer (sayı, metin, karakter)
+            if (isdigit((unsigned char)token[0]) || token[0] == '"' || token[0] == '\'') {
+                addChild(leafNode(LITERAL, token));
+                currentToken = getNextToken();
+                expectOperand = false;
+                continue;
+            }
+            if (token == "(") {
+                uint32_t start = currentStart();
+                // Tür dönüşümü veya sizeof(tip)
+                if (isType(peekToken(0)) && peekToken(1) == ")") {
+                    currentToken = getNextToken();
+                    NodeId type = leafNode(TYPE, currentToken);
+                    addChild(type);
+                    currentToken = getNextToken();
+                    currentToken = getNextToken();  // )'yi atla
+                    bool sizeofType = operators.size() > base && operators.back().text == "sizeof";
+                    std::string_view next = currentToken;
+                    const OperatorInfo* info = findOperator(next);
+                    if (!sizeofType && !next.empty() &&
+                        (isalnum((unsigned char)next[0]) || next[0] == '_' || next[0] == '"' ||
+                         next[0] == '\'' || next == "(" || (info && info->prefix))) {
+                        operators.push_back({OP_CAST, PREC_UNARY, CAST_EXPR, std::string_view(), start, 0});
+                    } else {
+                        // Tip tek başına operanddır
+                        ParseNode& node = tree->nodes[type];
+                        node.spanStart = start - segmentStart;
+                        node.spanLength = consumedEnd - start;
+                        expectOperand = false;
+                    }
+                    continue;
+                }
+                operators.push_back({OP_PAREN, 0, EXPRESSION, std::string_view(), start, 0});
+                ++groups;
+                currentToken = getNextToken();
+                continue;
+            }
+            // Önek operatörleri
+            const OperatorInfo* info = findOperator(token);
+            if (info && info->prefix) {
+                operators.push_back({OP_PREFIX, PREC_UNARY, UNARY_EXPR, token, currentStart(), 0});
+                currentToken = getNextToken();
+                continue;
+            }
+            if (closesExpression(token)) {
+                // Eksik operand; token'ı çevreleyen yapı işler
+                addChild(leafNode(EXPRESSION));
+            } else {
+                // Hata durumu; düğüm atlanan token'ı kapsar
+                uint32_t start = currentStart();
+                currentToken = getNextToken();
+                addChild(finishNode(EXPRESSION, mark(), start));
+            }
+            expectOperand = false;
+            continue;
+        }
+
+        // Operand okundu; sıradaki token operatör, sonek veya grup kapanışı olabilir
+        const OperatorInfo* info = findOperator(token);
+        if (!info) {
+            break;  // İfadeye devam etmeyen token
+        }
+        switch (info->role) {
+            // Sonekler en sıkı bağlanır ve tepedeki operanda hemen uygulanır
+            case ROLE_CALL:
+            case ROLE_INDEX: {
+                uint32_t from = (uint32_t)pending.size() - 1;
+                uint32_t start = nodeStart(pending.back());
+                currentToken = getNextToken();
+                if (info->role == ROLE_CALL && currentToken == ")") {
+                    // Argümansız çağrı
+                    currentToken = getNextToken();
+                    addChild(finishNode(CALL_EXPR, from, start));
+                    continue;
+                }
+                if (info->role == ROLE_CALL) {
+                    operators.push_back({OP_CALL, 0, CALL_EXPR, std::string_view(), start, from});
+                } else {
+                    operators.push_back({OP_INDEX, 0, INDEX_EXPR, std::string_view(), start, from});
+                }
+                ++groups;
+                expectOperand = true;
+                continue;
+            }
+            case ROLE_MEMBER: {
+                size_t from = pending.size() - 1;
+                uint32_t start = nodeStart(pending.back());
+                currentToken = getNextToken();
+                if (!currentToken.empty() && (isalpha((unsigned char)currentToken[0]) || currentToken[0] == '_')) {
+                    addChild(leafNode(IDENTIFIER, currentToken));
+                    currentToken = getNextToken();
+                } else {
+                    addChild(leafNode(EXPRESSION));
+                }
+                addChild(finishNode(MEMBER_EXPR, from, start, token));
+                continue;
+            }
+            // Grup kapanışı; önce grubun içindeki operatörler indirgenir
+            case ROLE_CLOSE: {
+                while (operators.size() > base && operators.back().kind < OP_PAREN) reduceOperator();
+                if (groups == 0) break;  // Kapanış ifadeyi çevreleyen yapıya ait
+                ExprOpKind kind = operators.back().kind;
+                bool matches = token == ")" ? (kind == OP_PAREN || kind == OP_CALL) : kind == OP_INDEX;
+                --groups;
+                if (!matches) {
+                    // Kapanmamış iç grup burada biter; kapanış dıştaki gruba bakar
+                    reduceOperator();
+                    continue;
+                }
+                currentToken = getNextToken();
+                closeGroup();
+                continue;
+            }
+            // Virgül: çağrıda argüman ayırıcı, diğer gruplarda ve deyimlerde işlem
+            case ROLE_COMMA:
+                while (operators.size() > base && operators.back().kind < OP_PAREN) reduceOperator();
+                if (groups > 0 && operators.back().kind == OP_CALL) {
+                    currentToken = getNextToken();
+                    expectOperand = true;
+                    continue;
+                }
+                if (groups == 0 && minPrecedence > PREC_COMMA) break;
+                operators.push_back({OP_BINARY, PREC_COMMA, BINARY_EXPR, token, 0, 0});
+                currentToken = getNextToken();
+                expectOperand = true;
+                continue;
+            // Üçlü işlem: '?' bir grup açar, ':' onu üç operandlı bir operatöre çevirir
+            case ROLE_QUESTION:
+                while (operators.size() > base && operators.back().kind < OP_PAREN &&
+                       operators.back().precedence > PREC_CONDITIONAL) {
+                    reduceOperator();
+                }
+                if (groups == 0 && minPrecedence > PREC_CONDITIONAL) break;
+                operators.push_back({OP_QUESTION, 0, CONDITIONAL_EXPR, std::string_view(), 0, 0});
+                ++groups;
+                currentToken = getNextToken();
+                expectOperand = true;
+                continue;
+            case ROLE_COLON: {
+                while (operators.size() > base && operators.back().kind < OP_PAREN) reduceOperator();
+                if (groups == 0 || operators.back().kind != OP_QUESTION) break;  // Etiket veya case
+                --groups;
+                ExprOp& op = operators.back();
+                op.kind = OP_CONDITIONAL;
+                op.precedence = PREC_CONDITIONAL;
+                currentToken = getNextToken();
+                expectOperand = true;
+                continue;
+            }
+            case ROLE_OPERATOR: {
+                if (info->postfix) {
+                    uint32_t start = nodeStart(pending.back());
+                    currentToken = getNextToken();
+                    addChild(finishNode(POSTFIX_EXPR, pending.size() - 1, start, token));
+                    continue;
+                }
+                if (!info->binary) break;  // '!' ve '~' yalnızca önektir
+                // Sıkı bağlanan operatörler indirgenir; sağdan birleşenlerde eşit öncelik beklemede kalır
+                int precedence = info->binary;
+                bool right = rightAssociative(precedence);
+                while (operators.size() > base && operators.back().kind < OP_PAREN &&
+                       (operators.back().precedence > precedence ||
+                        (operators.back().precedence == precedence && !right))) {
+                    reduceOperator();
+                }
+                if (groups == 0 && precedence < minPrecedence) break;
+                NodeType type = precedence == PREC_ASSIGN ? ASSIGNMENT_EXPR : BINARY_EXPR;
+                operators.push_back({OP_BINARY, (uint8_t)precedence, type, token, 0, 0});
+                currentToken = getNextToken();
+                expectOperand = true;
+                continue;
+            }
+        }
+        // İfadeye devam etmeyen token
+        break;
+    }
+    // Kalan operatörler ve kapanmamış gruplar indirgenir
+    while (operators.size() > base) reduceOperator();
+    NodeId result = pending.back();
+    pending.pop_back();
+    return result;
+}
+
+// Değişken tanımlamalarını ayrıştırır
+NodeId Parser::parseVariableDecl() {
+    size_t m = mark();
+    uint32_t start = currentStart();
+    // Veri tipini ayrıştır
+    addChild(leafNode(TYPE, currentToken));
+    currentToken = getNextToken();
+    // Değişken adını ayrıştır
+    addChild(symbolNode(currentToken, SYMBOL_VARIABLE));
+    currentToken = getNextToken();
+    // İlk değer ataması varsa ayrıştır
+    if (currentToken == "=") {
+        currentToken = getNextToken();
+        addChild(parseExpression(PREC_ASSIGN));
+    }
+    // Noktalı virgülü atla
+    if (currentToken == ";") {
+        currentToken = getNextToken();
+    }
+    return finishNode(VARIABLE_DECL, m, start);
+}
+
+// Parametreleri ayrıştırır
+NodeId Parser::parseParameter() {
+    size_t m = mark();
+    uint32_t start = currentStart();
+    // Parametre tipini ayrıştır
+    if (isType(currentToken)) {
+        addChild(leafNode(TYPE, currentToken));
+        currentToken = getNextToken();
+        // Parametre adını ayrıştır
+        if (!isKeyword(currentToken)) {
+            addChild(symbolNode(currentToken, SYMBOL_PARAMETER));
+            currentToken = getNextToken();
+        }
+    }
+    return finishNode(PARAM, m, start);
+}
+
+// Kod bloklarını ayrıştırır
+// Az önce tüketilen '{' ile başlar
+NodeId Parser::parseBlock() {
+    size_t m = mark();
+    uint32_t start = consumedStart;
+    while (currentToken != "}" && !currentToken.empty()) {
+        // Noktalı virgülleri atla
+        if (currentToken == ";") {
+            currentToken = getNextToken();
+            continue;
+        }
+        // İfadeleri ayrıştır
+        NodeId stmt = parseStatement();
+        if (tree->type(stmt) != EXPRESSION || tree->childCount(stmt) != 0) {
+            addChild(stmt);
+        }
+    }
+    if (currentToken == "}") {
+        currentToken = getNextToken();
+    }
+    return finishNode(BLOCK_STATEMENT, m, start);
+}
+
+// İfadeleri ayrıştırır (if, while, for, return, değişken tanımı, atama)
+NodeId Parser::parseStatement() {
+    if (currentToken == "if") {
+        return parseIfStatement();
+    } else if (currentToken == "while") {
+        return parseWhileStatement();
+    } else if (currentToken == "for") {
+        return parseForStatement();
+    } else if (currentToken == "return") {
+        return parseReturnStatement();
+    } else if (isType(currentToken)) {
+        return parseVariableDecl();
+    } else {
+        const char* before = currentToken.data();
+        NodeId stmt = parseExpression();
+        if (currentToken.data() == before && !currentToken.empty()) {
+            // Hiçbir ifade başlatmayan token (ör. fazladan bir ')'); boş ifade ağaca eklenmez
+            currentToken = getNextToken();
+            return stmt;
+        }
+        if (currentToken == ";") {
+            currentToken = getNextToken();
+        }
+        return stmt;
+    }
+}
+
+// If ifadelerini ayrıştırır
+NodeId Parser::parseIfStatement() {
+    size_t m = mark();
+    uint32_t start = currentStart();
+    currentToken = getNextToken(); // if'i atla
+    // Koşul ifadesini ayrıştır
+    if (currentToken == "(") {
+        currentToken = getNextToken();
+        addChild(parseExpression());
+        if (currentToken == ")") {
+            currentToken = getNextToken();
+        }
+    }
+    // If bloğunu ayrıştır
+    if (currentToken == "{") {
+        currentToken = getNextToken();
+        addChild(parseBlock());
+        if (currentToken == "}") {
+            currentToken = getNextToken();
+        }
+    }
+    // Else bloğunu ayrıştır
+    if (currentToken == "else") {
+        currentToken = getNextToken();
+        if (currentToken == "{") {
+            currentToken = getNextToken();
+            addChild(parseBlock());
+            if (currentToken == "}") {
+                currentToken = getNextToken();
+            }
+        }
+    }
+    return finishNode(IF_STATEMENT, m, start);
+}
+// While döngülerini ayrıştırır
+NodeId Parser::parseWhileStatement() {
+    size_t m = mark();
+    uint32_t start = currentStart();
+    currentToken = getNextToken(); // while'i atla
+    // Koşul ifadesini ayrıştır
+    if (currentToken == "(") {
+        currentToken = getNextToken();
+        addChild(parseExpression());
+        if (currentToken == ")") {
+            currentToken = getNextToken();
+        }
+    }
+    // While bloğunu ayrıştır
+    if (currentToken == "{") {
+        currentToken = getNextToken();
+        addChild(parseBlock());
+        if (currentToken == "}") {
+            currentToken = getNextToken();
+        }
+    }
+    return finishNode(WHILE_STATEMENT, m, start);
+}
+// For döngülerini ayrıştırır
+NodeId Parser::parseForStatement() {
+    size_t m = mark();
+    uint32_t start = currentStart();
+    currentToken = getNextToken(); // for'u atla
+    if (currentToken == "(") {
+        currentToken = getNextToken();
+        // Başlangıç ifadesi veya değişken tanımı (';' ile birlikte)
+        if (isType(currentToken)) {
+            addChild(parseVariableDecl());
+        } else {
+            addChild(parseExpression());
+            if (currentToken == ";") {
+                currentToken = getNextToken();
+            }
+        }
+        // Koşul ifadesi
+        addChild(parseExpression());
+        if (currentToken == ";") {
+            currentToken = getNextToken();
+        }
+        // Artırma ifadesi
+        addChild(parseExpression());
+        if (currentToken == ")") {
+            currentToken = getNextToken();
+        }
+    }
+    // For bloğunu ayrıştır
+    if (currentToken == "{") {
+        currentToken = getNextToken();
+        addChild(parseBlock());
+        if (currentToken == "}") {
+            currentToken = getNextToken();
+        }
+    }
+    return finishNode(FOR_STATEMENT, m, start);
+}
+// Return ifadelerini ayrıştırır
+NodeId Parser::parseReturnStatement() {
+    size_t m = mark();
+    uint32_t start = currentStart();
+    currentToken = getNextToken(); // return'u atla
+    // Dönüş değerini ayrıştır
+    addChild(parseExpression());
+    if (currentToken == ";") {
+        currentToken = getNextToken();
+    }
+    return finishNode(RETURN_STATEMENT, m, start);
+}
+// Fonksiyon tanımlarını ayrıştırır
+NodeId Parser::parseFunctionDef() {
+    size_t m = mark();
+    uint32_t start = currentStart();
+    // Dönüş tipini ayrıştır
+    if (isType(currentToken)) {
+        addChild(leafNode(TYPE, currentToken));
+        currentToken = getNextToken();
+    }
+    // Fonksiyon adını ayrıştır
+    if (!isKeyword(currentToken)) {
+        addChild(symbolNode(currentToken, SYMBOL_FUNCTION));
+        currentToken = getNextToken();
+    }
+    // Parametre listesini ayrıştır
+    size_t paramMark = mark();
+    uint32_t paramStart = currentStart();
+    if (currentToken == "(") {
+        currentToken = getNextToken();
+        // Parametreleri ayrıştır
+        while (currentToken != ")" && !currentToken.empty()) {
+            if (isType(currentToken)) {
+                addChild(parseParameter());
+                if (currentToken == ",") {
+                    currentToken = getNextToken();
+                }
+            } else {
+                currentToken = getNextToken();
+            }
+        }
+        currentToken = getNextToken(); // )'yi atla
+    }
+    addChild(finishNode(PARAM_LIST, paramMark, paramStart));
+    // Fonksiyon gövdesini ayrıştır
+    if (currentToken == "{") {
+        currentToken = getNextToken();
+        addChild(parseBlock());
+        if (currentToken == "}") {
+            currentToken = getNextToken();
+        }
+    }
+    return finishNode(FUNCTION_DEF, m, start);
+}
+
+// Sıradaki üst düzey öğeyi ayrıştırır
+bool Parser::parseTopLevel(TopLevelItem& item) {
+    // Noktalı virgülleri atla
+    if (currentToken == ";") {
+        currentToken = getNextToken();
+        return false;
+    }
+    // Öğenin düğümleri kendi bölümüne göre konumlanır
+    item.start = offsetOf(currentToken);
+    item.segment = (uint32_t)tree->segmentBase.size();
+    item.firstNode = (uint32_t)tree->nodes.size();
+    item.firstChildId = (uint32_t)tree->childIds.size();
+    tree->segmentBase.push_back(item.start);
+    segment = item.segment;
+    segmentStart = item.start;
+    peekEnd = 0;
+
+    NodeId node;
+    // Fonksiyon tanımı veya değişken tanımı
+    if (isType(currentToken)) {
+        // Tipten sonra ad, addan sonra '(' geliyorsa fonksiyon tanımıdır
+        if (peekToken(1) == "(") {
+            node = parseFunctionDef();
+        } else {
+            node = parseVariableDecl();
+        }
+    }
+    // Diğer ifadeler
+    else {
+        node = parseStatement();
+    }
+    item.node = node;
+    item.nodeEnd = (uint32_t)tree->nodes.size();
+    item.childIdEnd = (uint32_t)tree->childIds.size();
+    segment = 0;
+    segmentStart = 0;
+
+    // Boş ifadeler ağaca eklenmez
+    if (tree->type(node) == EXPRESSION && tree->childCount(node) == 0) {
+        tree->segmentBase.pop_back();
+        tree->garbage += (item.nodeEnd - item.firstNode) + (item.childIdEnd - item.firstChildId);
+        return false;
+    }
+    // Öğenin bittiğine karar vermek için bakılan token
+    if (currentToken.empty()) {
+        item.nextStart = (uint32_t)text.size();
+        item.nextEnd = END_OF_TEXT;
+    } else {
+        item.nextStart = offsetOf(currentToken);
+        item.nextEnd = item.nextStart + (uint32_t)currentToken.size();
+        // Bitişik bir karakter operatörü uzatabilir ('!' → '!='); o karakter de öğeye bağlıdır
+        if (findOperator(currentToken)) item.nextEnd += 1;
+    }
+    // Öğenin tipine karar verirken daha ileriye bakılmış olabilir ('int f //c\n(' gibi)
+    item.nextEnd = std::max(item.nextEnd, peekEnd);
+    return true;
+}
+
+// Üst düzey öğelerden PROGRAM düğümünü oluşturur
+void Parser::finishRoot() {
+    size_t m = mark();
+    for (const TopLevelItem& item : tree->items) {
+        addChild(item.node);
+    }
+    tree->rootNode = finishNode(PROGRAM, m, 0);
+    // Kök, ağacın metninin tamamını kapsar
+    tree->nodes[tree->rootNode].spanLength = (uint32_t)tree->source.size();
+}
+
+// Görünümler çağıranın metnine ait, saklanmasın
+void Parser::release() {
+    currentToken = std::string_view();
+    consumedStart = consumedEnd = 0;
+    text = std::string_view();
+    tokens = nullptr;
+    tree = nullptr;
+}
+
+// Token akışını ayrıştırır ve sözdizimi ağacını oluşturur
+void Parser::parse(std::string_view metin, const std::vector<Token>& tokenlar, ParseTree& agac) {
+    text = metin;
+    tokens = &tokenlar;
+    tokenIndex = 0;
+    wasCancelled = false;
+    cancelCheck = 0;
+    tree = &agac;
+    // Önceki ağacın belleğini yeniden kullan; kabaca token sayısı kadar düğüm beklenir
+    tree->reset();
+    tree->source = metin;
+    tree->nodes.reserve(tokenlar.size());
+    tree->childIds.reserve(tokenlar.size());
+    pending.clear();
+
+    currentToken = getNextToken();
+    while (!currentToken.empty()) {
+        TopLevelItem item;
+        if (parseTopLevel(item)) {
+            tree->items.push_back(item);
+        }
+    }
+    // Yarım kalan ağaç ne eski ne yeni metne uyar; kök kurulmaz ve
+    // sonraki reparse() ağacı baştan kurar
+    if (!wasCancelled) finishRoot();
+    release();
+}
+
+// Düzenlemeden etkilenen üst düzey öğeleri yeniden ayrıştırır
+void Parser::reparse(std::string_view metin, const std::vector<Token>& tokenlar,
+                     const DegisimAraligi& degisim, ParseTree& agac) {
+    // Önceki ağaç yoksa veya çöp canlı düğümlerden fazlaysa baştan kur
+    if (agac.rootNode == NO_NODE ||
+        agac.garbage * 2 > agac.nodes.size() + agac.childIds.size()) {
+        parse(metin, tokenlar, agac);
+        return;
+    }
+    text = metin;
+    tokens = &tokenlar;
+    wasCancelled = false;
+    cancelCheck = 0;
+    tree = &agac;
+    pending.clear();
+    reparsed.clear();
+
+    std::vector<TopLevelItem>& items = tree->items;
+    const long long delta = (long long)degisim.yeniBitis - degisim.eskiBitis;
+
+    // Sonraki token'ı düzenlemeden önce biten öğeler olduğu gibi kalır
+    size_t first = std::partition_point(items.begin(), items.end(), [&degisim](const TopLevelItem& item) {
+        return item.nextEnd <= (uint32_t)degisim.baslangic;
+    }) - items.begin();
+    // Ayrıştırma, korunan son öğenin bittiği token'dan devam eder
+    uint32_t restart = first > 0 ? items[first - 1].nextStart : 0;
+    consumedStart = consumedEnd = restart;
+    tokenIndex = std::lower_bound(tokenlar.begin(), tokenlar.end(), restart,
+                                  [](const Token& t, uint32_t konum) { return (uint32_t)t.baslangic < konum; })
+                 - tokenlar.begin();
+
+    // Kök düğüm her seferinde yeniden oluşturulur; havuzun sonunda
+    // olduğundan yeri çöp bırakmadan geri alınabilir
+    const ParseNode& oldRoot = tree->nodes[tree->rootNode];
+    if (tree->rootNode + 1 == tree->nodes.size() &&
+        oldRoot.firstChild + oldRoot.childCount == tree->childIds.size()) {
+        tree->childIds.resize(oldRoot.firstChild);
+        tree->nodes.pop_back();
+    } else {
+        tree->garbage += 1 + oldRoot.childCount;
+    }
+    tree->rootNode = NO_NODE;
+
+    const size_t segmentCount = tree->segmentBase.size();
+    const size_t nodeCount = tree->nodes.size();
+    const size_t childIdCount = tree->childIds.size();
+    const size_t symbolRefCount = tree->symbolRefs.size();
+    size_t oldNext = first;  // Yeni konumu henüz geçilmemiş ilk eski öğe
+    bool converged = false;
+    currentToken = getNextToken();
+    while (!currentToken.empty()) {
+        // Düzenlemeden sonra eski bir öğenin başladığı token'a gelindiyse
+        // geri kalan öğeler değişmemiştir
+        long long pos = offsetOf(currentToken);
+        if (pos >= degisim.yeniBitis) {
+            long long oldPos = pos - delta;
+            while (oldNext < items.size() && items[oldNext].start < oldPos) ++oldNext;
+            if (oldNext < items.size() && items[oldNext].start == oldPos) {
+                converged = true;
+                break;
+            }
+        }
+        TopLevelItem item;
+        if (parseTopLevel(item)) {
+            reparsed.push_back(item);
+        }
+    }
+    if (wasCancelled) {
+        // Ağaç eski metne göre geçerliliğini korur; eklenen düğümler çöptür
+        tree->segmentBase.resize(segmentCount);
+        tree->symbolRefs.resize(symbolRefCount);
+        tree->garbage += (tree->nodes.size() - nodeCount) + (tree->childIds.size() - childIdCount);
+        finishRoot();
+        release();
+        return;
+    }
+
+    // Yerini yenilerine bırakan öğeler çöp olur
+    size_t last = converged ? oldNext : items.size();
+    for (size_t i = first; i < last; ++i) {
+        tree->garbage += (items[i].nodeEnd - items[i].firstNode) + (items[i].childIdEnd - items[i].firstChildId);
+    }
+    // Düzenlemeden sonraki öğeleri kaydır; düğümleri bölüm başlangıcına göreli olduğundan değişmez
+    if (delta != 0) {
+        for (size_t i = last; i < items.size(); ++i) {
+            TopLevelItem& item = items[i];
+            item.start += (uint32_t)delta;
+            item.nextStart += (uint32_t)delta;
+            if (item.nextEnd != END_OF_TEXT) item.nextEnd += (uint32_t)delta;
+            tree->segmentBase[item.segment] += (uint32_t)delta;
+        }
+    }
+    items.erase(items.begin() + first, items.begin() + last);
+    items.insert(items.begin() + first, reparsed.begin(), reparsed.end());
+
+    tree->source = metin;
+    finishRoot();
+    release();
+}
+
+const char* nodeTypeName(NodeType type) {
+    switch (type) {
+        case PROGRAM: return "Program";
+        case FUNCTION_DEF: return "Fonksiyon Tanımı";
+        case VARIABLE_DECL: return "Değişken Tanımı";
+        case PARAM_LIST: return "Parametre Listesi";
+        case PARAM: return "Parametre";
+        case STATEMENT: return "İfade";
+        case IF_STATEMENT: return "If İfadesi";
+        case WHILE_STATEMENT: return "While Döngüsü";
+        case FOR_STATEMENT: return "For Döngüsü";
+        case RETURN_STATEMENT: return "Return İfadesi";
+        case EXPRESSION: return "İfade";
+        case BINARY_EXPR: return "İkili İşlem";
+        case UNARY_EXPR: return "Tekli İşlem";
+        case ASSIGNMENT_EXPR: return "Atama İfadesi";
+        case LITERAL: return "Sabit Değer";
+        case IDENTIFIER: return "Tanımlayıcı";
+        case TYPE: return "Veri Tipi";
+        case BLOCK_STATEMENT: return "Kod Bloğu";
+        case CONDITIONAL_EXPR: return "Üçlü İşlem";
+        case CALL_EXPR: return "Fonksiyon Çağrısı";
+        case INDEX_EXPR: return "Dizi Erişimi";
+        case MEMBER_EXPR: return "Üye Erişimi";
+        case POSTFIX_EXPR: return "Sonek İşlem";
+        case CAST_EXPR: return "Tür Dönüşümü";
+        default: return "Bilinmeyen";
+    }
+}
+
+const char* childRole(NodeType type, uint32_t index) {
+    static const char* ifRoles[] = {"İfade: Koşul", "Kod Bloğu: Then Bloğu", "Kod Bloğu: Else Bloğu"};
+    static const char* whileRoles[] = {"İfade: Koşul", "Kod Bloğu: Döngü Gövdesi"};
+    static const char* forRoles[] = {"İfade: Başlangıç", "İfade: Koşul", "İfade: Artırma", "Kod Bloğu: Döngü Gövdesi"};
+    switch (type) {
+        case IF_STATEMENT: return index < 3 ? ifRoles[index] : nullptr;
+        case WHILE_STATEMENT: return index < 2 ? whileRoles[index] : nullptr;
+        case FOR_STATEMENT: return index < 4 ? forRoles[index] : nullptr;
+        default: return nullptr;
+    }
+}
@@ -0,0 +1,435 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "lexer.h"
+
+// Sözdizimi ağacı için düğüm tipleri
+// Her düğüm tipi, kodun farklı bir yapısal öğesini temsil eder
+enum NodeType {
+    PROGRAM,            // Programın kök düğümü
+    FUNCTION_DEF,       // Fonksiyon tanımı
+    VARIABLE_DECL,      // Değişken tanımı
+    PARAM_LIST,         // Parametre listesi
+    PARAM,              // Tek bir parametre
+    STATEMENT,          // Genel ifade
+    IF_STATEMENT,       // If koşul ifadesi
+    WHILE_STATEMENT,    // While döngü ifadesi
+    FOR_STATEMENT,      // For döngü ifadesi
+    RETURN_STATEMENT,   // Return ifadesi
+    EXPRESSION,         // Genel ifade
+    BINARY_EXPR,        // İkili işlem (+, -, *, /, vb.)
+    UNARY_EXPR,         // Tekli işlem
+    ASSIGNMENT_EXPR,    // Atama ifadesi
+    LITERAL,            // Sabit değer (sayı, metin, karakter)
+    IDENTIFIER,         // Tanımlayıcı (değişken, fonksiyon adı)
+    TYPE,               // Veri tipi
+    BLOCK_STATEMENT,    // Kod bloğu
+    CONDITIONAL_EXPR,   // Üçlü işlem (koşul ? a : b)
+    CALL_EXPR,          // Fonksiyon çağrısı; ilk alt düğüm çağrılan, diğerleri argümanlar
+    INDEX_EXPR,         // Dizi erişimi (a[i])
+    MEMBER_EXPR,        // Üye erişimi (a.b, a->b)
+    POSTFIX_EXPR,       // Sonek işlem (a++, a--)
+    CAST_EXPR           // Tür dönüşümü ((int)a)
+};
+
+// Düğüm tipinin görünümlerde ve çıktılarda kullanılan adı
+const char* nodeTypeName(NodeType type);
+// Koşul ve döngü ifadelerinin alt düğümlerine verilen etiketler (yoksa nullptr)
+// Ağacın kendisi değiştirilmez; bu etiketler yalnızca görünümde ara düğüm olarak eklenir
+const char* childRole(NodeType type, uint32_t index);
+
+// Düğümlerin ağaç içindeki 32 bitlik indeksi
+typedef uint32_t NodeId;
+const NodeId NO_NODE = 0xFFFFFFFFu;
+// Metnin sonuna kadar bakmış bir üst düzey öğenin 'nextEnd' değeri
+const uint32_t END_OF_TEXT = 0xFFFFFFFFu;
+
+// Sözdizimi ağacı düğüm yapısı
+// Her düğüm, kodun bir parçasını ve onun alt öğelerini temsil eder.
+// Değer ve düğümün kapsadığı kaynak (span) metin içinde birer aralık, alt
+// düğümler ise ağacın ortak alt düğüm dizisinde ardışık bir aralıktır.
+// Aralıkların başlangıcı, düğümün ait olduğu üst düzey öğenin başlangıcına
+// görelidir; böylece bir düzenleme öğeyi kaydırdığında düğümlerine dokunmak
+// gerekmez. Alt düğümlerin kapsadığı aralıklar metindeki sırayla dizilidir
+// ve örtüşmez; bir konumdaki düğüm her düzeyde ikili aramayla bulunur.
+struct ParseNode {
+    uint64_t hash;         // Alt ağacın içerik özeti (tip, değer ve alt düğümler; konumdan bağımsız)
+    NodeType type;         // Düğümün tipi
+    uint32_t segment;      // Değerin ve kapsamın göreli olduğu bölüm (üst düzey öğe)
+    uint32_t valueStart;   // Değerin bölüm başlangıcına göre yeri
+    uint32_t valueLength;  // Değerin uzunluğu (0: değer yok)
+    uint32_t spanStart;    // Düğümün ilk token'ının bölüm başlangıcına göre yeri
+    uint32_t spanLength;   // İlk token'ın başından son token'ın sonuna kadar uzunluk
+    uint32_t firstChild;   // İlk alt düğümün alt düğüm dizisindeki yeri
+    uint32_t childCount;   // Alt düğüm sayısı
+};
+
+// Bir tanımlayıcı kaydının rolü
+enum SymbolRole : uint32_t {
+    SYMBOL_USE,        // İfadede kullanım
+    SYMBOL_VARIABLE,   // Değişken tanımı
+    SYMBOL_PARAMETER,  // Parametre tanımı
+    SYMBOL_FUNCTION    // Fonksiyon tanımı
+};
+
+// Ayrıştırma sırasında tanımlanan veya kullanılan bir ad
+// Adın metni ve konumu IDENTIFIER düğümündedir; kayıt da düğüm gibi
+// bölümüne görelidir ve düzenlemeler onu kaydırmaz.
+struct SymbolRef {
+    NodeId node;      // IDENTIFIER düğümü
+    SymbolRole role;
+};
+
+// Programın üst düzey bir öğesi (fonksiyon, değişken tanımı veya ifade)
+// Bir öğenin ayrıştırılması yalnızca [start, nextEnd) aralığındaki token'lara
+// bağlıdır; bu aralığa dokunmayan bir düzenlemeden sonra öğe yeniden kullanılır.
+struct TopLevelItem {
+    NodeId node;            // Öğenin kök düğümü
+    uint32_t segment;       // Öğenin düğüm değerlerinin göreli olduğu bölüm
+    uint32_t start;         // İlk token'ın başlangıcı
+    uint32_t nextStart;     // Öğe bitince bakılan sonraki token'ın başlangıcı
+    uint32_t nextEnd;       // Sonraki token'ın ya da ileriye bakılan en uzak token'ın bitişi
+                            // (metin sonuna bakıldıysa END_OF_TEXT)
+    uint32_t firstNode;     // Öğenin düğüm havuzundaki aralığı [firstNode, nodeEnd)
+    uint32_t nodeEnd;
+    uint32_t firstChildId;  // Öğenin alt düğüm dizisindeki aralığı [firstChildId, childIdEnd)
+    uint32_t childIdEnd;
+};
+
+// Ağacın dizilerine ham erişim
+// Önbellek dosyaları ağacı bu dizilerin birebir kopyası olarak saklar;
+// dosya belleğe eşlendiğinde ağaç ParseTreeView ile kopyalanmadan okunur.
+struct ParseTreeImage {
+    const ParseNode* nodes = nullptr;
+    size_t nodeCount = 0;
+    const NodeId* childIds = nullptr;
+    size_t childIdCount = 0;
+    const TopLevelItem* items = nullptr;
+    size_t itemCount = 0;
+    const uint32_t* segmentBase = nullptr;
+    size_t segmentCount = 0;
+    const SymbolRef* symbolRefs = nullptr;
+    size_t symbolRefCount = 0;
+    NodeId root = NO_NODE;
+    size_t garbage = 0;
+    uint64_t generation = 0;  // Ağaç baştan kurulunca değişir (önbellekten okunan ağaçta 0)
+};
+
+// Bütün düğümleri tek bir havuzda tutan sözdizimi ağacı
+// Düğümler ve alt düğüm listeleri iki dizide arka arkaya yer alır;
+// ağacı silmek bu dizileri sıfırlamaktan ibarettir ve ayrılan bellek
+// bir sonraki ayrıştırmada yeniden kullanılır. Artımlı ayrıştırmada
+// havuza yalnızca ekleme yapılır; yerini yenisine bırakan öğelerin
+// düğümleri çöp olarak sayılır ve çöp çoğalınca ağaç baştan kurulur.
+class ParseTree {
+public:
+    ParseTree() : rootNode(NO_NODE), garbage(0), generation(0) { segmentBase.push_back(0); }
+
+    // Ağacı boşaltır, belleği bir sonraki ayrıştırma için saklar
+    void reset() {
+        nodes.clear();
+        childIds.clear();
+        items.clear();
+        segmentBase.assign(1, 0);
+        symbolRefs.clear();
+        rootNode = NO_NODE;
+        garbage = 0;
+        ++generation;
+        source = std::string_view();
+    }
+
+    NodeId root() const { return rootNode; }
+    size_t nodeCount() const { return nodes.size(); }
+    const ParseNode& node(NodeId id) const { return nodes[id]; }
+    NodeType type(NodeId id) const { return nodes[id].type; }
+    std::string_view value(NodeId id) const {
+        const ParseNode& n = nodes[id];
+        return source.substr(segmentBase[n.segment] + n.valueStart, n.valueLength);
+    }
+    // Düğümün kapsadığı metin aralığı [spanStart, spanEnd)
+    uint32_t spanStart(NodeId id) const { return segmentBase[nodes[id].segment] + nodes[id].spanStart; }
+    uint32_t spanEnd(NodeId id) const { return spanStart(id) + nodes[id].spanLength; }
+    uint32_t childCount(NodeId id) const { return nodes[id].childCount; }
+    // Aynı içerikteki alt ağaçların özeti eşittir; görünüm değişen kısmı bulmak için kullanır
+    uint64_t hash(NodeId id) const { return nodes[id].hash; }
+    NodeId child(NodeId id, uint32_t i) const { return childIds[nodes[id].firstChild + i]; }
+    // Programın üst düzey öğeleri, metindeki sırasıyla
+    const std::vector<TopLevelItem>& topLevelItems() const { return items; }
+    // Ayrıştırırken kaydedilen tanım ve kullanımlar, oluşturuldukları sırayla
+    // Artımlı ayrıştırmada yalnızca ekleme yapılır; yerini yenisine bırakan
+    // öğelerin kayıtları, bölümleri artık bir öğeye ait olmadığından tanınır
+    size_t symbolRefCount() const { return symbolRefs.size(); }
+    const SymbolRef& symbolRef(size_t i) const { return symbolRefs[i]; }
+    // Havuzda artık ağaca bağlı olmayan düğüm ve alt düğüm kaydı sayısı
+    size_t garbageSize() const { return garbage; }
+    // Ağacın ayırdığı toplam bellek (bayt)
+    size_t memoryUsage() const {
+        return nodes.capacity() * sizeof(ParseNode) + childIds.capacity() * sizeof(NodeId) +
+               items.capacity() * sizeof(TopLevelItem) + segmentBase.capacity() * sizeof(uint32_t) +
+               symbolRefs.capacity() * sizeof(SymbolRef);
+    }
+
+    // Dizilerin ham görüntüsü; ağaç değişene kadar geçerlidir
+    ParseTreeImage image() const {
+        ParseTreeImage img;
+        img.nodes = nodes.data();
+        img.nodeCount = nodes.size();
+        img.childIds = childIds.data();
+        img.childIdCount = childIds.size();
+        img.items = items.data();
+        img.itemCount = items.size();
+        img.segmentBase = segmentBase.data();
+        img.segmentCount = segmentBase.size();
+        img.symbolRefs = symbolRefs.data();
+        img.symbolRefCount = symbolRefs.size();
+        img.root = rootNode;
+        img.garbage = garbage;
+        img.generation = generation;
+        return img;
+    }
+    // Ağacı bir görüntünün kopyasıyla değiştirir; değerler 'text' üzerinde olur
+    // Sonraki artımlı ayrıştırmalar bu ağaçtan devam edebilir
+    void assign(const ParseTreeImage& img, std::string_view text) {
+        nodes.assign(img.nodes, img.nodes + img.nodeCount);
+        childIds.assign(img.childIds, img.childIds + img.childIdCount);
+        items.assign(img.items, img.items + img.itemCount);
+        segmentBase.assign(img.segmentBase, img.segmentBase + img.segmentCount);
+        if (segmentBase.empty()) segmentBase.push_back(0);
+        symbolRefs.assign(img.symbolRefs, img.symbolRefs + img.symbolRefCount);
+        rootNode = img.root;
+        garbage = img.garbage;
+        ++generation;
+        source = text;
+    }
+
+    std::string_view source;  // Değerlerin işaret ettiği metin (ağaca ait değil)
+
+private:
+    friend class Parser;
+    std::vector<ParseNode> nodes;  // Düğüm havuzu
+    std::vector<NodeId> childIds;  // Bütün düğümlerin alt düğüm listeleri, ardışık
+    std::vector<TopLevelItem> items;    // Üst düzey öğeler
+    std::vector<uint32_t> segmentBase;  // Her bölümün metindeki güncel başlangıcı (0: kök)
+    std::vector<SymbolRef> symbolRefs;  // Tanım ve kullanım kayıtları
+    NodeId rootNode;               // PROGRAM düğümü
+    size_t garbage;                // Çöp düğüm ve alt düğüm kaydı sayısı
+    uint64_t generation;           // reset() ve assign() sayısı
+};
+
+// Başka bir yerde duran ağaç dizileri üzerinde salt okunur görünüm
+// ParseTree ile aynı okuma arayüzünü sunar; diziler ve metin görünümden
+// uzun yaşamalıdır (ör. belleğe eşlenmiş bir önbellek dosyası).
+class ParseTreeView {
+public:
+    ParseTreeView() {}
+    ParseTreeView(const ParseTreeImage& image, std::string_view text) : source(text), img(image) {}
+
+    NodeId root() const { return img.root; }
+    size_t nodeCount() const { return img.nodeCount; }
+    const ParseNode& node(NodeId id) const { return img.nodes[id]; }
+    NodeType type(NodeId id) const { return img.nodes[id].type; }
+    std::string_view value(NodeId id) const {
+        const ParseNode& n = img.nodes[id];
+        return source.substr(img.segmentBase[n.segment] + n.valueStart, n.valueLength);
+    }
+    uint32_t spanStart(NodeId id) const { return img.segmentBase[img.nodes[id].segment] + img.nodes[id].spanStart; }
+    uint32_t spanEnd(NodeId id) const { return spanStart(id) + img.nodes[id].spanLength; }
+    uint32_t childCount(NodeId id) const { return img.nodes[id].childCount; }
+    uint64_t hash(NodeId id) const { return img.nodes[id].hash; }
+    NodeId child(NodeId id, uint32_t i) const { return img.childIds[img.nodes[id].firstChild + i]; }
+    size_t symbolRefCount() const { return img.symbolRefCount; }
+    const SymbolRef& symbolRef(size_t i) const { return img.symbolRefs[i]; }
+    const ParseTreeImage& image() const { return img; }
+
+    std::string_view source;  // Değerlerin işaret ettiği metin
+
+private:
+    ParseTreeImage img;
+};
+
+// 'node'un 'offset'teki karakteri kapsayan alt düğümünün sırası; yoksa childCount
+// Alt düğümlerin bitişleri azalmadığı için ikili aramadır (ParseTree veya ParseTreeView)
+template <typename Tree>
+uint32_t childIndexAt(const Tree& tree, NodeId node, uint32_t offset) {
+    uint32_t low = 0, high = tree.childCount(node);
+    const uint32_t count = high;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (tree.spanEnd(tree.child(node, mid)) <= offset) low = mid + 1;
+        else high = mid;
+    }
+    if (low < count && tree.spanStart(tree.child(node, low)) <= offset) return low;
+    return count;
+}
+
+// 'offset'teki karakteri kapsayan en içteki düğüm; kök de kapsamıyorsa NO_NODE
+// 'path' verilirse kökten o düğüme kadar bütün düğümler sırayla yazılır; en
+// içteki deyim veya fonksiyon bu yoldan okunur. Her düzeyde bir ikili arama
+// yapılır: O(derinlik · log alt düğüm sayısı).
+template <typename Tree>
+NodeId nodeAt(const Tree& tree, uint32_t offset, std::vector<NodeId>* path = nullptr) {
+    if (path) path->clear();
+    NodeId node = tree.root();
+    if (node == NO_NODE || offset < tree.spanStart(node) || offset >= tree.spanEnd(node)) return NO_NODE;
+    for (;;) {
+        if (path) path->push_back(node);
+        uint32_t i = childIndexAt(tree, node, offset);
+        if (i == tree.childCount(node)) return node;
+        node = tree.child(node, i);
+    }
+}
+
+// Yukarıdan aşağıya sözdizimi çözümleyici sınıfı
+// Lexer'ın ürettiği token akışını okuyup sözdizimi ağacını oluşturur
+class Parser {
+public:
+    std::string_view text;              // Token'ların ait olduğu metin
+    const std::vector<Token>* tokens;   // Okunan token akışı
+    size_t tokenIndex;                  // Sıradaki token'ın indeksi
+    std::string_view currentToken;      // Şu anki işlenen token (text üzerinde bir görünüm)
+    uint32_t consumedStart;             // currentToken'dan önce tüketilen son token'ın başlangıcı
+    uint32_t consumedEnd;               // ve bitişi; düğümlerin kapsamı buraya kadar uzanır
+    uint32_t peekEnd;                   // Öğe ayrıştırılırken peekToken()'ın baktığı en uzak konum
+
+private:
+    ParseTree* tree;                    // Düğümlerin yazıldığı ağaç
+    std::vector<NodeId> pending;        // Tamamlanmamış düğümlerin alt düğümleri
+    uint32_t segment;                   // Oluşturulan düğümlerin bölümü
+    uint32_t segmentStart;              // Bölümün metindeki başlangıcı
+    std::vector<TopLevelItem> reparsed; // Artımlı ayrıştırmada yeniden oluşturulan öğeler
+
+    // İptal kontrolü; her CANCEL_CHECK_INTERVAL token'da bir bakılır
+    static const size_t CANCEL_CHECK_INTERVAL = 1024;
+    const std::atomic<unsigned long>* cancelCounter;  // Güncel nesil sayacı (nullptr: iptal yok)
+    unsigned long parseGeneration;      // Bu ayrıştırmanın nesli
+    size_t cancelCheck;                 // Son kontrolden beri okunan token sayısı
+    bool wasCancelled;                  // Son ayrıştırma iptal edildi mi
+
+    bool isType(std::string_view token);
+    bool isKeyword(std::string_view token);
+
+    std::string_view getNextToken();
+    std::string_view peekToken(size_t ahead = 0);
+    // tokens[index]'teki token'ı okur ve index'i ilerletir; bitişik
+    // operatör karakterleri tek bir C operatörü olarak birleştirilir
+    std::string_view readToken(size_t& index) const;
+
+    // İfade ayrıştırıcısının yığınındaki bir operatör veya grup işareti
+    // Gruplar ('(', çağrı, '[', '?') kapanana kadar içlerindeki
+    // operatörlerin dışarıdakilerle indirgenmesini engeller; listenin
+    // sonundadırlar (kind >= OP_PAREN)
+    enum ExprOpKind : uint8_t {
+        OP_BINARY,       // İki operand
+        OP_PREFIX,       // Bir operand
+        OP_CAST,         // Veri tipi ve bir operand
+        OP_CONDITIONAL,  // ':' görülmüş üçlü işlem; üç operand
+        OP_PAREN,        // Grup: parantezli ifade
+        OP_CALL,         // Grup: çağrı argümanları
+        OP_INDEX,        // Grup: dizi indeksi
+        OP_QUESTION      // Grup: '?' ile ':' arasındaki ifade
+    };
+    struct ExprOp {
+        ExprOpKind kind;
+        uint8_t precedence;     // Operatörlerde Precedence, gruplarda kullanılmaz
+        NodeType type;          // İndirgenince oluşturulan düğüm
+        std::string_view text;  // Düğümün değeri (operatör)
+        uint32_t start;         // Önek ve gruplarda kapsamın başlangıcı
+        uint32_t from;          // Gruplarda ilk operandın 'pending' içindeki yeri
+    };
+    std::vector<ExprOp> operators;  // İfade ayrıştırıcısının operatör yığını
+
+    // Yığının tepesindeki operatörü 'pending'in tepesindeki operandlarla
+    // birleştirir; grup işaretleri kapanmamış sayılarak bitirilir
+    void reduceOperator();
+    // Tepedeki grubu kapanış token'ı tüketildikten sonra bitirir
+    void closeGroup();
+    // Düğümün kapsamının metindeki başlangıcı (yalnızca bu bölümün düğümleri)
+    uint32_t nodeStart(NodeId id) const { return segmentStart + tree->nodes[id].spanStart; }
+
+    // Düğüm oluşturma
+    // Bir düğümün alt düğümleri önce 'pending' yığınına eklenir; düğüm
+    // tamamlanınca işaretten sonraki kısım ağacın alt düğüm dizisine taşınır
+    size_t mark() const { return pending.size(); }
+    void addChild(NodeId child) { pending.push_back(child); }
+    // Düğümün kapsamı 'start'tan son tüketilen token'ın sonuna (ve değerin sonuna) kadardır
+    NodeId finishNode(NodeType type, size_t from, uint32_t start, std::string_view value = std::string_view());
+    NodeId leafNode(NodeType type, std::string_view value = std::string_view());
+    // 'token' adıyla bir IDENTIFIER düğümü oluşturur ve tanım ya da kullanım olarak kaydeder
+    NodeId symbolNode(std::string_view token, SymbolRole role);
+    // Token'ın metindeki başlangıcı
+    uint32_t offsetOf(std::string_view token) const { return (uint32_t)(token.data() - text.data()); }
+    // Sıradaki token'ın başlangıcı; metin bittiyse metnin sonu
+    uint32_t currentStart() const { return currentToken.empty() ? (uint32_t)text.size() : offsetOf(currentToken); }
+
+    // Sıradaki üst düzey öğeyi ayrıştırır; ağaca eklenecek bir öğe
+    // oluştuysa 'item'ı doldurup true döndürür
+    bool parseTopLevel(TopLevelItem& item);
+    // Üst düzey öğelerden PROGRAM düğümünü oluşturur
+    void finishRoot();
+    // Ayrıştırmadan sonra metne ait görünümleri bırakır
+    void release();
+
+    // minPrecedence'tan zayıf bağlanan bir ikili operatör ifadeyi bitirir;
+    // değişken ilk değeri gibi virgülün ayırıcı olduğu yerlerde PREC_ASSIGN verilir
+    NodeId parseExpression(int minPrecedence = PREC_COMMA);
+    NodeId parseVariableDecl();
+    NodeId parseParameter();
+    NodeId parseBlock();
+    NodeId parseStatement();
+    NodeId parseIfStatement();
+    NodeId parseWhileStatement();
+    NodeId parseForStatement();
+    NodeId parseReturnStatement();
+    NodeId parseFunctionDef();
+
+public:
+    // C operatör öncelikleri; büyük sayı daha sıkı bağlar
+    enum Precedence {
+        PREC_NONE,
+        PREC_COMMA,           // ,
+        PREC_ASSIGN,          // = += -= *= /= %= <<= >>= &= ^= |= (sağdan)
+        PREC_CONDITIONAL,     // ?: (sağdan)
+        PREC_LOGICAL_OR,      // ||
+        PREC_LOGICAL_AND,     // &&
+        PREC_BIT_OR,          // |
+        PREC_BIT_XOR,         // ^
+        PREC_BIT_AND,         // &
+        PREC_EQUALITY,        // == !=
+        PREC_RELATIONAL,      // < <= > >=
+        PREC_SHIFT,           // << >>
+        PREC_ADDITIVE,        // + -
+        PREC_MULTIPLICATIVE,  // * / %
+        PREC_UNARY            // Önek operatörleri ve tür dönüşümü (sağdan)
+    };
+
+    // Yapıcı fonksiyon
+    Parser()
+        : tokens(nullptr), tokenIndex(0), consumedStart(0), consumedEnd(0), peekEnd(0), tree(nullptr), segment(0), segmentStart(0),
+          cancelCounter(nullptr), parseGeneration(0), cancelCheck(0), wasCancelled(false) {}
+    // Token akışını ayrıştırır ve sözdizimi ağacını 'agac' içine yazar
+    // metin, token'ların konumlarının işaret ettiği metindir; ağacın
+    // değerleri bu metin yaşadığı sürece geçerlidir
+    void parse(std::string_view metin, const std::vector<Token>& tokenlar, ParseTree& agac);
+    // 'agac' önceki metnin ağacıyken, token'ları 'degisim' aralığında değişen
+    // yeni metne göre günceller. Düzenlemeden önce ve sonra kalan üst düzey
+    // öğeler yeniden kullanılır, yalnızca etkilenen öğeler yeniden ayrıştırılır.
+    // Çöp çoğaldıysa ağaç parse() ile baştan kurulur (ağacın 'generation'ı
+    // değişir); bu kurulum iptal edilirse ağacın kökü olmaz.
+    void reparse(std::string_view metin, const std::vector<Token>& tokenlar,
+                 const DegisimAraligi& degisim, ParseTree& agac);
+    // Sonraki ayrıştırmaları bir nesil sayacına bağlar; sayaç 'generation'
+    // değerinden farklılaşırsa ayrıştırma yarıda bırakılır
+    void setCancellation(const std::atomic<unsigned long>* counter, unsigned long generation) {
+        cancelCounter = counter;
+        parseGeneration = generation;
+    }
+    // Son ayrıştırma iptal edildiyse ağaç eksiktir ve kullanılmamalıdır
+    bool cancelled() const { return wasCancelled; }
+};
+
+#endif
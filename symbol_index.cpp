@@ -0,0 +1,175 @@
+#include "symbol_index.h"
+#include <algorithm>
+
+namespace {
+
+// FNV-1a; adlar kısa olduğundan bayt bayt karıştırmak yeterlidir
+uint32_t nameHash(std::string_view name) {
+    uint32_t h = 2166136261u;
+    for (unsigned char c : name) h = (h ^ c) * 16777619u;
+    return h;
+}
+
+} // namespace
+
+// Adın bulunduğu ya da eklenmesi gereken yuva
+size_t SymbolTable::slotOf(std::string_view name, uint32_t hash) const {
+    const size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        SymbolId id = slots[i];
+        if (id == NO_SYMBOL || (hashes[id] == hash && this->name(id) == name)) return i;
+    }
+}
+
+// Tabloyu iki katına çıkarır; yük yarıyı geçmez
+void SymbolTable::grow() {
+    size_t size = slots.empty() ? 1024 : slots.size() * 2;
+    slots.assign(size, NO_SYMBOL);
+    const size_t mask = size - 1;
+    for (SymbolId id = 0; id < hashes.size(); ++id) {
+        size_t i = hashes[id] & mask;
+        while (slots[i] != NO_SYMBOL) i = (i + 1) & mask;
+        slots[i] = id;
+    }
+}
+
+SymbolId SymbolTable::intern(std::string_view name) {
+    if ((used + 1) * 2 > slots.size()) grow();
+    uint32_t hash = nameHash(name);
+    size_t slot = slotOf(name, hash);
+    if (slots[slot] != NO_SYMBOL) return slots[slot];
+    if (nameStart.empty()) nameStart.push_back(0);
+    SymbolId id = (SymbolId)hashes.size();
+    names.append(name.data(), name.size());
+    nameStart.push_back((uint32_t)names.size());
+    hashes.push_back(hash);
+    slots[slot] = id;
+    ++used;
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view name) const {
+    if (slots.empty()) return NO_SYMBOL;
+    return slots[slotOf(name, nameHash(name))];
+}
+
+void SymbolTable::clear() {
+    names.clear();
+    nameStart.clear();
+    hashes.clear();
+    slots.clear();
+    used = 0;
+}
+
+void SymbolIndex::update(uint32_t file, const ParseTreeImage& tree, std::string_view text) {
+    if (file >= files.size()) files.resize(file + 1);
+    FileState& f = files[file];
+    // Ağaç baştan kurulduysa dosyanın bütün kayıtları eskir
+    if (f.generation != tree.generation || tree.symbolRefCount < f.indexedRefs) {
+        staleEntries += f.liveEntries;
+        liveEntries -= f.liveEntries;
+        f.liveEntries = 0;
+        f.indexedRefs = 0;
+        ++f.epoch;
+        f.liveSegment.clear();
+        f.segmentEntries.clear();
+    }
+    f.generation = tree.generation;
+    f.segmentBase.assign(tree.segmentBase, tree.segmentBase + tree.segmentCount);
+
+    // Bölümler yalnızca üst düzey öğeleri ağaçta kaldıkça canlıdır; artımlı
+    // ayrıştırma yeni öğelere yeni bölümler verir, eskilerini yeniden kullanmaz
+    std::vector<uint8_t> live(tree.segmentCount, 0);
+    for (size_t i = 0; i < tree.itemCount; ++i) live[tree.items[i].segment] = 1;
+    if (f.segmentEntries.size() < tree.segmentCount) f.segmentEntries.resize(tree.segmentCount, 0);
+    for (size_t s = 0; s < f.liveSegment.size(); ++s) {
+        if (f.liveSegment[s] && (s >= live.size() || !live[s])) {
+            staleEntries += f.segmentEntries[s];
+            liveEntries -= f.segmentEntries[s];
+            f.liveEntries -= f.segmentEntries[s];
+            f.segmentEntries[s] = 0;
+        }
+    }
+    f.liveSegment.swap(live);
+
+    // Son çağrıdan beri eklenen kayıtlar
+    for (size_t i = f.indexedRefs; i < tree.symbolRefCount; ++i) {
+        const SymbolRef& ref = tree.symbolRefs[i];
+        const ParseNode& node = tree.nodes[ref.node];
+        // Bu çağrıya kadar yerini yenisine bırakmış bir öğenin kaydı
+        if (!f.liveSegment[node.segment]) continue;
+        std::string_view name = text.substr(f.segmentBase[node.segment] + node.valueStart, node.valueLength);
+        SymbolId id = table.intern(name);
+        if (id >= entries.size()) entries.resize(id + 1);
+        Entry e = {file, f.epoch, node.segment, node.valueStart, ref.role};
+        if (ref.role == SYMBOL_USE) entries[id].uses.push_back(e);
+        else entries[id].definitions.push_back(e);
+        f.segmentEntries[node.segment]++;
+        f.liveEntries++;
+        liveEntries++;
+    }
+    f.indexedRefs = tree.symbolRefCount;
+
+    // Ağaçtaki çöp gibi, eskiyen kayıtlar canlılardan çoksa temizlenir
+    if (staleEntries > liveEntries) compact();
+}
+
+size_t SymbolIndex::collect(const std::vector<Entry>& list, uint32_t length, std::vector<SymbolLocation>& out) const {
+    size_t before = out.size();
+    for (const Entry& e : list) {
+        if (!valid(e)) continue;
+        out.push_back(SymbolLocation{e.file, files[e.file].segmentBase[e.segment] + e.start, length, e.role});
+    }
+    return out.size() - before;
+}
+
+size_t SymbolIndex::definitions(std::string_view name, std::vector<SymbolLocation>& out) const {
+    SymbolId id = table.find(name);
+    if (id == NO_SYMBOL || id >= entries.size()) return 0;
+    return collect(entries[id].definitions, (uint32_t)name.size(), out);
+}
+
+size_t SymbolIndex::uses(std::string_view name, std::vector<SymbolLocation>& out) const {
+    SymbolId id = table.find(name);
+    if (id == NO_SYMBOL || id >= entries.size()) return 0;
+    return collect(entries[id].uses, (uint32_t)name.size(), out);
+}
+
+// Kaydı kalmayan adlar da havuzdan çıkarılır; düzenlerken yazılıp silinen
+// adlar birikmez. Kimlikler dizinin dışına verilmediği için yeniden atanabilir.
+void SymbolIndex::compact() {
+    auto stale = [this](const Entry& e) { return !valid(e); };
+    SymbolTable kept;
+    std::vector<SymbolEntries> keptEntries;
+    for (SymbolId id = 0; id < entries.size(); ++id) {
+        SymbolEntries& s = entries[id];
+        s.definitions.erase(std::remove_if(s.definitions.begin(), s.definitions.end(), stale), s.definitions.end());
+        s.uses.erase(std::remove_if(s.uses.begin(), s.uses.end(), stale), s.uses.end());
+        if (s.definitions.empty() && s.uses.empty()) continue;
+        kept.intern(table.name(id));
+        keptEntries.push_back(std::move(s));
+    }
+    table = std::move(kept);
+    entries = std::move(keptEntries);
+    staleEntries = 0;
+}
+
+void SymbolIndex::clear() {
+    table.clear();
+    entries.clear();
+    files.clear();
+    liveEntries = staleEntries = 0;
+}
+
+size_t SymbolIndex::memoryUsage() const {
+    size_t total = table.memoryUsage() + entries.capacity() * sizeof(SymbolEntries) +
+                   files.capacity() * sizeof(FileState);
+    for (const SymbolEntries& s : entries) {
+        total += (s.definitions.capacity() + s.uses.capacity()) * sizeof(Entry);
+    }
+    for (const FileState& f : files) {
+        total += f.segmentBase.capacity() * sizeof(uint32_t) + f.liveSegment.capacity() +
+                 f.segmentEntries.capacity() * sizeof(uint32_t);
+    }
+    return total;
+}
@@ -0,0 +1,129 @@
+#ifndef SYMBOL_INDEX_H
+#define SYMBOL_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "parser.h"
+
+// Adların 32 bitlik kimliği
+typedef uint32_t SymbolId;
+const SymbolId NO_SYMBOL = 0xFFFFFFFFu;
+
+// Ad havuzu (interner)
+// Her farklı ad bir kez saklanır ve sırayla bir kimlik alır; aynı ad her
+// zaman aynı kimliği alır. Adlar tek bir bitişik tamponda, kimlikler açık
+// adreslemeli bir karma tablosunda durur.
+class SymbolTable {
+public:
+    SymbolTable() : used(0) {}
+
+    // Adın kimliği; ad ilk kez görülüyorsa eklenir
+    SymbolId intern(std::string_view name);
+    // Adın kimliği; yoksa NO_SYMBOL
+    SymbolId find(std::string_view name) const;
+    // Görünüm bir sonraki intern() çağrısına kadar geçerlidir
+    std::string_view name(SymbolId id) const {
+        return std::string_view(names).substr(nameStart[id], nameStart[id + 1] - nameStart[id]);
+    }
+    size_t size() const { return hashes.size(); }
+    void clear();
+    size_t memoryUsage() const {
+        return names.capacity() + nameStart.capacity() * sizeof(uint32_t) + hashes.capacity() * sizeof(uint32_t) +
+               slots.capacity() * sizeof(SymbolId);
+    }
+
+private:
+    std::string names;               // Bütün adlar, arka arkaya
+    std::vector<uint32_t> nameStart; // Her adın 'names' içindeki başlangıcı; sonunda toplam uzunluk
+    std::vector<uint32_t> hashes;    // Her adın özeti; tablo büyürken yeniden hesaplanmaz
+    std::vector<SymbolId> slots;     // Karma tablosu (NO_SYMBOL: boş); boyutu ikinin kuvveti
+    size_t used;
+
+    size_t slotOf(std::string_view name, uint32_t hash) const;
+    void grow();
+};
+
+// Bir tanımın veya kullanımın bulunduğu yer
+struct SymbolLocation {
+    uint32_t file;    // update() çağrısındaki dosya numarası
+    uint32_t start;   // Adın dosyanın güncel metnindeki başlangıcı
+    uint32_t length;
+    SymbolRole role;
+};
+
+// Tanım/kullanım çapraz başvuru dizini
+// Ayrıştırıcının ağaca yazdığı tanım ve kullanım kayıtlarını ad kimliğine
+// göre toplar; bir adın tanımları ve kullanımları ağaç dolaşılmadan, bir
+// karma araması ve sonuç sayısı kadar işle bulunur. Birden çok dosya
+// numarasıyla aynı dizine eklenebilir.
+//
+// update() aynı dosyanın ağacı her değiştiğinde yeniden çağrılır ve yalnızca
+// son çağrıdan beri eklenen kayıtları işler. Artımlı ayrıştırmada yerini
+// yenisine bırakan öğelerin kayıtları hemen silinmez, bölümleri artık bir
+// öğeye ait olmadığı için sorgularda atlanır; eskiyen kayıtlar canlı olanları
+// geçince dizin sıkıştırılır. Adların ağaçta hangi kapsamda olduğuna
+// bakılmaz: "tanıma git" aynı adı taşıyan bütün tanımları döndürür.
+class SymbolIndex {
+public:
+    SymbolIndex() : liveEntries(0), staleEntries(0) {}
+
+    // 'file' numaralı dosyanın ağacını dizine katar; 'text' ağacın metnidir
+    // Metin ve ağaç çağrıdan sonra tutulmaz
+    void update(uint32_t file, const ParseTreeImage& tree, std::string_view text);
+    template <typename Tree>
+    void update(uint32_t file, const Tree& tree) {
+        update(file, tree.image(), tree.source);
+    }
+
+    // Adın tanımlarını veya kullanımlarını 'out'un sonuna ekler ve eklenen sayıyı döndürür
+    // Sonuçlar dosya ve konuma göre sıralı değildir
+    size_t definitions(std::string_view name, std::vector<SymbolLocation>& out) const;
+    size_t uses(std::string_view name, std::vector<SymbolLocation>& out) const;
+
+    const SymbolTable& symbols() const { return table; }
+    // Sorgularda görünen kayıt sayısı
+    size_t entryCount() const { return liveEntries; }
+    void clear();
+    size_t memoryUsage() const;
+
+private:
+    struct Entry {
+        uint32_t file;
+        uint32_t epoch;    // Kaydedildiğinde dosyanın dönemi; ağaç baştan kurulunca eskir
+        uint32_t segment;  // Kaydın bölümü
+        uint32_t start;    // Adın bölüm başlangıcına göre yeri
+        SymbolRole role;
+    };
+    struct SymbolEntries {
+        std::vector<Entry> definitions;
+        std::vector<Entry> uses;
+    };
+    struct FileState {
+        uint64_t generation = 0;            // Son işlenen ağacın nesli
+        uint32_t epoch = 0;
+        size_t indexedRefs = 0;             // Ağacın işlenmiş kayıt sayısı
+        size_t liveEntries = 0;
+        std::vector<uint32_t> segmentBase;  // Bölümlerin güncel başlangıçları
+        std::vector<uint8_t> liveSegment;   // Bölüm bir üst düzey öğeye ait mi
+        std::vector<uint32_t> segmentEntries;  // Bölümdeki kayıt sayısı
+    };
+
+    SymbolTable table;
+    std::vector<SymbolEntries> entries;  // Ad kimliğine göre
+    std::vector<FileState> files;
+    size_t liveEntries;
+    size_t staleEntries;
+
+    bool valid(const Entry& e) const {
+        const FileState& f = files[e.file];
+        return e.epoch == f.epoch && e.segment < f.liveSegment.size() && f.liveSegment[e.segment];
+    }
+    size_t collect(const std::vector<Entry>& list, uint32_t length, std::vector<SymbolLocation>& out) const;
+    // Eskiyen kayıtları siler
+    void compact();
+};
+
+#endif
@@ -0,0 +1,220 @@
+#include "tarama.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TARAMA_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Skaler sürümler; vektör sürümleri de blok sonundaki artık baytlar için bunları kullanır
+
+inline bool tokenBaytiMi(unsigned char c) { return c >= 0x21 && c <= 0x7E; }
+inline bool kelimeBaytiMi(unsigned char c) {
+    return (unsigned char)((c | 0x20) - 'a') < 26 || (unsigned char)(c - '0') < 10 || c == '_';
+}
+
+size_t tokenBaslangiciSkaler(const char *p, size_t i, size_t n) {
+    while (i < n && !tokenBaytiMi((unsigned char)p[i])) ++i;
+    return i;
+}
+
+size_t kelimeSonuSkaler(const char *p, size_t i, size_t n) {
+    while (i < n && kelimeBaytiMi((unsigned char)p[i])) ++i;
+    return i;
+}
+
+size_t metinDuragiSkaler(const char *p, size_t i, size_t n, char kapanis) {
+    while (i < n && p[i] != kapanis && p[i] != '\\' && p[i] != '\n') ++i;
+    return i;
+}
+
+size_t yorumSonuSkaler(const char *p, size_t i, size_t n) {
+    while (i + 1 < n) {
+        const char *yildiz = static_cast<const char *>(std::memchr(p + i, '*', n - 1 - i));
+        if (!yildiz) break;
+        i = yildiz - p;
+        if (p[i + 1] == '/') return i;
+        ++i;
+    }
+    return n;
+}
+
+#ifdef TARAMA_X86
+
+// Her blokta koşulu sağlayan baytların maskesi hesaplanır; ilk set bit aranan konumdur.
+// Bloklar yalnızca tamamı aralığın içindeyse okunur, kalan baytlar skaler taranır.
+
+// SSE2 x86-64'te her zaman vardır; 32 bit derlemelerde de hedef olarak istenir
+__attribute__((target("sse2")))
+size_t tokenBaslangiciSse2(const char *p, size_t i, size_t n) {
+    const __m128i taban = _mm_set1_epi8(0x21);
+    const __m128i aralik = _mm_set1_epi8(0x7E - 0x21);
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)(p + i)), taban);
+        // x <= aralik (işaretsiz) ise bayt token başlatır
+        int m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(x, aralik), x));
+        if (m) return i + __builtin_ctz(m);
+    }
+    return tokenBaslangiciSkaler(p, i, n);
+}
+
+__attribute__((target("sse2")))
+size_t kelimeSonuSse2(const char *p, size_t i, size_t n) {
+    const __m128i kucukHarf = _mm_set1_epi8(0x20);
+    const __m128i a = _mm_set1_epi8('a'), harfAraligi = _mm_set1_epi8(25);
+    const __m128i sifir = _mm_set1_epi8('0'), rakamAraligi = _mm_set1_epi8(9);
+    const __m128i alt = _mm_set1_epi8('_');
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i h = _mm_sub_epi8(_mm_or_si128(v, kucukHarf), a);
+        __m128i r = _mm_sub_epi8(v, sifir);
+        __m128i kelime = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(h, harfAraligi), h),
+                         _mm_cmpeq_epi8(_mm_min_epu8(r, rakamAraligi), r)),
+            _mm_cmpeq_epi8(v, alt));
+        int m = ~_mm_movemask_epi8(kelime) & 0xFFFF;
+        if (m) return i + __builtin_ctz(m);
+    }
+    return kelimeSonuSkaler(p, i, n);
+}
+
+__attribute__((target("sse2")))
+size_t metinDuragiSse2(const char *p, size_t i, size_t n, char kapanis) {
+    const __m128i k = _mm_set1_epi8(kapanis);
+    const __m128i kacis = _mm_set1_epi8('\\');
+    const __m128i satir = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i dur = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, k), _mm_cmpeq_epi8(v, kacis)),
+                                   _mm_cmpeq_epi8(v, satir));
+        int m = _mm_movemask_epi8(dur);
+        if (m) return i + __builtin_ctz(m);
+    }
+    return metinDuragiSkaler(p, i, n, kapanis);
+}
+
+// Her bayt bir sonrakiyle birlikte denetlenir; bu yüzden blok bir bayt fazlasını okur
+__attribute__((target("sse2")))
+size_t yorumSonuSse2(const char *p, size_t i, size_t n) {
+    const __m128i yildiz = _mm_set1_epi8('*');
+    const __m128i bolu = _mm_set1_epi8('/');
+    for (; i + 17 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i sonraki = _mm_loadu_si128((const __m128i *)(p + i + 1));
+        int m = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v, yildiz), _mm_cmpeq_epi8(sonraki, bolu)));
+        if (m) return i + __builtin_ctz(m);
+    }
+    return yorumSonuSkaler(p, i, n);
+}
+
+__attribute__((target("avx2")))
+size_t tokenBaslangiciAvx2(const char *p, size_t i, size_t n) {
+    const __m256i taban = _mm256_set1_epi8(0x21);
+    const __m256i aralik = _mm256_set1_epi8(0x7E - 0x21);
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i *)(p + i)), taban);
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(x, aralik), x));
+        if (m) return i + __builtin_ctz(m);
+    }
+    return tokenBaslangiciSse2(p, i, n);
+}
+
+__attribute__((target("avx2")))
+size_t kelimeSonuAvx2(const char *p, size_t i, size_t n) {
+    const __m256i kucukHarf = _mm256_set1_epi8(0x20);
+    const __m256i a = _mm256_set1_epi8('a'), harfAraligi = _mm256_set1_epi8(25);
+    const __m256i sifir = _mm256_set1_epi8('0'), rakamAraligi = _mm256_set1_epi8(9);
+    const __m256i alt = _mm256_set1_epi8('_');
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i h = _mm256_sub_epi8(_mm256_or_si256(v, kucukHarf), a);
+        __m256i r = _mm256_sub_epi8(v, sifir);
+        __m256i kelime = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(h, harfAraligi), h),
+                            _mm256_cmpeq_epi8(_mm256_min_epu8(r, rakamAraligi), r)),
+            _mm256_cmpeq_epi8(v, alt));
+        unsigned m = ~(unsigned)_mm256_movemask_epi8(kelime);
+        if (m) return i + __builtin_ctz(m);
+    }
+    return kelimeSonuSse2(p, i, n);
+}
+
+__attribute__((target("avx2")))
+size_t metinDuragiAvx2(const char *p, size_t i, size_t n, char kapanis) {
+    const __m256i k = _mm256_set1_epi8(kapanis);
+    const __m256i kacis = _mm256_set1_epi8('\\');
+    const __m256i satir = _mm256_set1_epi8('\n');
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i dur = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, k), _mm256_cmpeq_epi8(v, kacis)),
+                                      _mm256_cmpeq_epi8(v, satir));
+        unsigned m = (unsigned)_mm256_movemask_epi8(dur);
+        if (m) return i + __builtin_ctz(m);
+    }
+    return metinDuragiSse2(p, i, n, kapanis);
+}
+
+__attribute__((target("avx2")))
+size_t yorumSonuAvx2(const char *p, size_t i, size_t n) {
+    const __m256i yildiz = _mm256_set1_epi8('*');
+    const __m256i bolu = _mm256_set1_epi8('/');
+    for (; i + 33 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i sonraki = _mm256_loadu_si256((const __m256i *)(p + i + 1));
+        unsigned m = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(v, yildiz), _mm256_cmpeq_epi8(sonraki, bolu)));
+        if (m) return i + __builtin_ctz(m);
+    }
+    return yorumSonuSse2(p, i, n);
+}
+
+#endif
+
+TaramaSeviyesi seciliSeviye = TS_SKALER;
+
+// Statik başlatma sırasında en iyi seviyeyi seçer
+struct TaramaBaslatici {
+    TaramaBaslatici() { taramaSeviyesiAyarla(desteklenenTaramaSeviyesi()); }
+};
+
+} // namespace
+
+// Başlatıcı çalışmadan önce de geçerli olsun diye skaler çekirdeklerle başlar
+TaramaCekirdekleri tarama = {tokenBaslangiciSkaler, kelimeSonuSkaler, metinDuragiSkaler, yorumSonuSkaler};
+
+namespace {
+TaramaBaslatici baslatici;
+}
+
+TaramaSeviyesi desteklenenTaramaSeviyesi() {
+#ifdef TARAMA_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return TS_AVX2;
+    if (__builtin_cpu_supports("sse2")) return TS_SSE2;
+#endif
+    return TS_SKALER;
+}
+
+TaramaSeviyesi taramaSeviyesi() { return seciliSeviye; }
+
+TaramaSeviyesi taramaSeviyesiAyarla(TaramaSeviyesi seviye) {
+    if (seviye > desteklenenTaramaSeviyesi()) seviye = desteklenenTaramaSeviyesi();
+    switch (seviye) {
+#ifdef TARAMA_X86
+    case TS_AVX2:
+        tarama = TaramaCekirdekleri{tokenBaslangiciAvx2, kelimeSonuAvx2, metinDuragiAvx2, yorumSonuAvx2};
+        break;
+    case TS_SSE2:
+        tarama = TaramaCekirdekleri{tokenBaslangiciSse2, kelimeSonuSse2, metinDuragiSse2, yorumSonuSse2};
+        break;
+#endif
+    default:
+        seviye = TS_SKALER;
+        tarama = TaramaCekirdekleri{tokenBaslangiciSkaler, kelimeSonuSkaler, metinDuragiSkaler, yorumSonuSkaler};
+        break;
+    }
+    seciliSeviye = seviye;
+    return seviye;
+}
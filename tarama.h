@@ -0,0 +1,39 @@
+#ifndef TARAMA_H
+#define TARAMA_H
+
+#include <cstddef>
+
+// Lexer'ın iç döngülerindeki karakter taramaları
+// Her çekirdek p[i, n) aralığında koşulu sağlayan ilk konumu, yoksa n'i
+// döndürür. Tarama 16 (SSE2) veya 32 (AVX2) baytlık bloklar halinde yapılır;
+// hangi sürümün kullanılacağı çalışma anında işlemciye göre seçilir.
+enum TaramaSeviyesi {
+    TS_SKALER = 0,  // Bayt bayt tarama (her platformda)
+    TS_SSE2,        // 16 baytlık bloklar
+    TS_AVX2         // 32 baytlık bloklar
+};
+
+struct TaramaCekirdekleri {
+    // Token başlatabilen ilk bayt (yazdırılabilir ASCII, boşluk hariç)
+    size_t (*tokenBaslangici)(const char *p, size_t i, size_t n);
+    // Tanımlayıcı veya sayı karakteri olmayan ilk bayt ([A-Za-z0-9_] dışı)
+    size_t (*kelimeSonu)(const char *p, size_t i, size_t n);
+    // Metin veya karakter sabitinde 'kapanis', '\\' ya da '\n' olan ilk bayt
+    size_t (*metinDuragi)(const char *p, size_t i, size_t n, char kapanis);
+    // Blok yorumu kapatan "*/" çiftinin '*' baytı; çift aralığın sonuna
+    // taşıyorsa (son bayt '*') bulunmamış sayılır
+    size_t (*yorumSonu)(const char *p, size_t i, size_t n);
+};
+
+// Seçili çekirdekler; ilk kullanımdan önce işlemcinin desteklediği en iyi seviye seçilir
+extern TaramaCekirdekleri tarama;
+
+// İşlemcinin desteklediği en yüksek seviye
+TaramaSeviyesi desteklenenTaramaSeviyesi();
+TaramaSeviyesi taramaSeviyesi();
+// Çekirdekleri verilen seviyeye (desteklenmiyorsa desteklenen en yükseğine)
+// geçirir ve seçilen seviyeyi döndürür. Ölçüm ve doğrulama içindir;
+// başka iş parçacıkları lexlerken çağrılmamalıdır.
+TaramaSeviyesi taramaSeviyesiAyarla(TaramaSeviyesi seviye);
+
+#endif
@@ -0,0 +1,9 @@
+#include "vurgulayici.h"
+
+void metin_degisti_cb(int pos, int nInserted, int nDeleted, int, const char *, void *v) {
+    if (nInserted || nDeleted) {
+        SyntaxVurgulayici *vurgulayici = static_cast<SyntaxVurgulayici *>(v);
+        DegisimAraligi aralik = vurgulayici->tokenize(pos, nInserted, nDeleted);
+        vurgulayici->vurgula(aralik);
+    }
+}
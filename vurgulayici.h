@@ -0,0 +1,202 @@
+#ifndef VURGULAYICI_H
+#define VURGULAYICI_H
+
+#include <FL/Fl.H>
+#include <FL/Fl_Text_Buffer.H>
+#include <FL/Fl_Text_Display.H>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include "belge.h"
+#include "lexer.h"
+#include "olcum.h"
+
+// Syntax vurgulama işlemlerini yapan ana sınıf
+// Büyük bir metin açıldığında veya yapıştırıldığında önce yalnızca görünen
+// kısım lexlenip renklendirilir. Geri kalanın stili STIL_BEKLIYOR olarak
+// bırakılır: görünüm böyle bir karakteri çizmeden önce stil_bekliyor_cb'yi
+// çağırır, kalan kısım da arayüz boştayken küçük dilimler halinde tamamlanır.
+class SyntaxVurgulayici {
+public:
+    // Henüz renklendirilmemiş karakterlerin stili (stil tablosunun hemen ardı)
+    static const char STIL_BEKLIYOR = 'A' + NOKTALAMA + 1;
+
+private:
+    // Açılışta, görünüm istediğinde ve boşta her adımda lexlenen bayt;
+    // bir düzenlemeden sonra yeniden lexlenecek en fazla bayt da budur
+    static const int DILIM = 64 * 1024;
+    // Bir boşta çağrısında harcanacak en fazla süre; sonra olaylara dönülür
+    static constexpr double BOSTA_SURE = 0.004;
+
+    Fl_Text_Buffer *metinBuffer;           // Düzenlenen metni tutan buffer
+    Fl_Text_Buffer *stilBuffer;            // Renk ve stil bilgilerini tutan buffer
+    TokenAkisi *akis;                      // Belgenin paylaşılan token akışı
+    Fl_Text_Display *gorunum;              // Stil değişince yeniden çizilecek görünüm
+    std::map<TokenTipi, Fl_Color> renkHaritasi;  // Token tiplerine göre renk eşleştirmeleri
+    int stilSiniri;                        // Stilleri hesaplanmış kısmın sonu; ötesi STIL_BEKLIYOR
+    bool bostaKayitli;                     // Boşta tamamlama kayıtlı mı
+    void (*tamamlandiCb)(void *);          // Boşta tamamlama bitince çağrılır
+    void *tamamlandiVeri;
+
+    // [baslangic, bitis) aralığında başlayan token sayısı (yalnızca ölçüm için)
+    size_t tokenSayisi(int baslangic, int bitis) const {
+        const TokenDeposu &tokenlar = akis->getTokenlar();
+        return tokenlar.ilkToken(bitis) - tokenlar.ilkToken(baslangic);
+    }
+
+    // Renklendirilmemiş kısım kaldıysa boşta tamamlamayı başlatır
+    void bostaBaslat() {
+        if (bostaKayitli || (stilSiniri >= metinBuffer->length() && akis->tamamlandi())) return;
+        bostaKayitli = true;
+        Fl::add_idle(bosta_cb, this);
+    }
+
+    // Arayüz boştayken BOSTA_SURE dolana kadar dilim dilim ilerler
+    static void bosta_cb(void *v) {
+        SyntaxVurgulayici *vurgulayici = static_cast<SyntaxVurgulayici *>(v);
+        std::chrono::steady_clock::time_point bas = std::chrono::steady_clock::now();
+        while (vurgulayici->ilerlet(vurgulayici->stilSiniri + DILIM)) {
+            std::chrono::duration<double> gecen = std::chrono::steady_clock::now() - bas;
+            if (gecen.count() >= BOSTA_SURE) break;
+        }
+    }
+
+public:
+    // Constructor: Buffer'ı ve token akışını alır, renk eşleştirmelerini hazırlar
+    // Akışın düzenleme başına yeniden lexleme bütçesi DILIM olur; yetişmeyen kısım boşta tamamlanır
+    SyntaxVurgulayici(Fl_Text_Buffer *buf, TokenAkisi *tokenAkisi)
+        : metinBuffer(buf), akis(tokenAkisi), gorunum(nullptr), stilSiniri(0), bostaKayitli(false),
+          tamamlandiCb(nullptr), tamamlandiVeri(nullptr) {
+        // Her token tipi için renk tanımlamaları
+        renkHaritasi = {
+            {ANAHTAR_KELIME, FL_RED},        // Anahtar kelimeler kırmızı
+            {TANIMLAYICI, FL_BLACK},         // Tanımlayıcılar siyah
+            {SAYI, FL_BLUE},                 // Sayılar mavi
+            {OPERATOR, FL_DARK_GREEN},       // Operatörler koyu yeşil
+            {METIN, FL_MAGENTA},             // String'ler mor
+            {KARAKTER, FL_DARKGOLD},        // Karakterler altın sarısı
+            {YORUM, FL_GRAY},                // Yorumlar gri
+            {BOSLUK, FL_WHITE},              // Boşluklar beyaz
+            {NOKTALAMA, FL_BLACK}            // Ayraçlar siyah
+        };
+        stilBuffer = new Fl_Text_Buffer();
+        akis->setButce(DILIM);
+    }
+
+    // Metnin yalnızca ilk ekranlarını token'lara ayırır
+    // Geri kalanı vurgula()'dan sonra boşta veya görünüm istedikçe lexlenir
+    void tokenize() {
+        OlcumKapsami olcum(OA_TOKENIZE);
+        akis->baslat(DILIM);
+        olcum.say(OS_BAYT, akis->lexSiniri());
+        olcum.say(OS_TOKEN, akis->getTokenlar().size());
+    }
+    // Bir düzenlemeden sonra düzenlemeyi belgeye uygular ve yalnızca
+    // etkilenen satırları yeniden token'lara ayırır
+    // Buffer'dan yalnızca eklenen metin okunur
+    DegisimAraligi tokenize(int pos, int nInserted, int nDeleted) {
+        OlcumKapsami olcum(OA_TOKENIZE);
+        char *eklenen = nInserted ? metinBuffer->text_range(pos, pos + nInserted) : nullptr;
+        DegisimAraligi aralik = akis->duzenle(pos, nDeleted, eklenen, nInserted);
+        free(eklenen);
+        if (olcum.olcuyor()) {
+            olcum.say(OS_BAYT, aralik.yeniBitis - aralik.baslangic);
+            olcum.say(OS_TOKEN, tokenSayisi(aralik.baslangic, aralik.yeniBitis));
+        }
+        return aralik;
+    }
+    // [baslangic, bitis) aralığının stil karakterlerini tek bir diziye yazar
+    void stilleriHesapla(int baslangic, int bitis, std::string &stil) const {
+        ::stilleriHesapla(akis->getTokenlar(), baslangic, bitis, stil);
+    }
+    // Bulunan token'lara göre bütün metni renklendirir
+    // Lexlenmemiş kısım STIL_BEKLIYOR ile doldurulur ve boşta tamamlanır
+    void vurgula() {
+        OlcumKapsami olcum(OA_VURGULA);
+        std::string stil;
+        stilSiniri = std::min(akis->lexSiniri(), metinBuffer->length());
+        stilleriHesapla(0, stilSiniri, stil);
+        stil.resize(metinBuffer->length(), STIL_BEKLIYOR);
+        stilBuffer->text(stil.c_str());
+        if (gorunum) gorunum->redisplay_range(0, metinBuffer->length());
+        olcum.say(OS_BAYT, stilSiniri);
+        bostaBaslat();
+    }
+    // Yalnızca token'ları değişen aralığın stilini tek bir işlemle günceller
+    // Stil buffer'ı eski metnin uzunluğunda olduğu için eski aralık yenisiyle değiştirilir
+    void vurgula(const DegisimAraligi &aralik) {
+        OlcumKapsami olcum(OA_VURGULA);
+        std::string stil;
+        int son = aralik.baslangic;
+        // Renklendirilmemiş kısımdaki düzenleme orayı beklemede bırakır
+        if (aralik.baslangic < stilSiniri) {
+            son = std::min(aralik.yeniBitis, akis->lexSiniri());
+            stilleriHesapla(aralik.baslangic, son, stil);
+            // Aralık stil sınırından önce bittiyse sınırın gerisi yalnızca kayar;
+            // yoksa lexlenemeyen kısım beklemeye alınır
+            stilSiniri = aralik.eskiBitis < stilSiniri ? stilSiniri + aralik.yeniBitis - aralik.eskiBitis : son;
+        }
+        stil.resize(aralik.yeniBitis - aralik.baslangic, STIL_BEKLIYOR);
+        stilBuffer->replace(aralik.baslangic, aralik.eskiBitis, stil.data(), (int)stil.size());
+        if (gorunum) gorunum->redisplay_range(aralik.baslangic, aralik.yeniBitis);
+        olcum.say(OS_BAYT, son - aralik.baslangic);
+        bostaBaslat();
+    }
+    // Lexlenmiş ve renklendirilmiş kısmı en az 'hedef' konumuna kadar uzatır
+    // İş kalmadıysa boşta tamamlamayı kaldırır, tamamlandı callback'ini çağırır ve false döndürür
+    bool ilerlet(int hedef) {
+        if (!akis->tamamlandi() && akis->lexSiniri() < hedef) {
+            OlcumKapsami olcum(OA_TOKENIZE);
+            int once = akis->lexSiniri();
+            akis->ilerlet(hedef);
+            olcum.say(OS_BAYT, akis->lexSiniri() - once);
+        }
+        // Akış başka biri tarafından (ör. lexical analiz penceresi) ilerletilmiş de olabilir
+        int son = std::min(akis->lexSiniri(), metinBuffer->length());
+        if (son > stilSiniri) {
+            OlcumKapsami olcum(OA_VURGULA);
+            std::string stil;
+            stilleriHesapla(stilSiniri, son, stil);
+            stilBuffer->replace(stilSiniri, son, stil.data(), (int)stil.size());
+            if (gorunum) gorunum->redisplay_range(stilSiniri, son);
+            olcum.say(OS_BAYT, stil.size());
+            stilSiniri = son;
+        }
+        if (stilSiniri < metinBuffer->length() || !akis->tamamlandi()) return true;
+        if (bostaKayitli) {
+            Fl::remove_idle(bosta_cb, this);
+            bostaKayitli = false;
+            if (tamamlandiCb) tamamlandiCb(tamamlandiVeri);
+        }
+        return false;
+    }
+    // Metnin geri kalanını hemen lexler ve renklendirir
+    void tamamla() { ilerlet(INT_MAX); }
+    // Görünüm, stili STIL_BEKLIYOR olan bir karakteri çizmeden önce çağırır
+    // Oraya kadar olan kısım ve ardından bir dilim daha renklendirilir
+    static void stil_bekliyor_cb(int pos, void *v) {
+        SyntaxVurgulayici *vurgulayici = static_cast<SyntaxVurgulayici *>(v);
+        vurgulayici->ilerlet(pos + DILIM);
+    }
+    // Boşta tamamlama bittiğinde çağrılacak fonksiyonu ayarlar
+    void setTamamlandiCb(void (*cb)(void *), void *veri) {
+        tamamlandiCb = cb;
+        tamamlandiVeri = veri;
+    }
+    // Stil değişikliklerinin yeniden çizileceği görünümü ayarlar
+    void setGorunum(Fl_Text_Display *g) { gorunum = g; }
+    // Stil buffer'ını dışarıya aç
+    Fl_Text_Buffer *getStilBuffer() { return stilBuffer; }
+    // Token listesini dışarıya aç
+    const TokenDeposu& getTokenlar() const { return akis->getTokenlar(); }
+};
+
+// Metin değiştiğinde çağrılan callback
+// Token'ları düzenlemeye göre günceller ve değişen aralığı yeniden renklendirir
+void metin_degisti_cb(int pos, int nInserted, int nDeleted, int, const char *, void *v);
+
+#endif
@@ -0,0 +1,50 @@
+#include "work_pool.h"
+#include <thread>
+#include <vector>
+
+WorkStealingPool::WorkStealingPool(unsigned count) : threadCount(count) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    queues.reset(new Queue[threadCount]);
+}
+
+bool WorkStealingPool::next(unsigned worker, size_t& index) {
+    {
+        Queue& own = queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.items.empty()) {
+            index = own.items.front();
+            own.items.pop_front();
+            return true;
+        }
+    }
+    // Komşudan başlayarak sırayla dene; çalınan iş kuyruğun sonundaki en küçük iştir
+    for (unsigned i = 1; i < threadCount; ++i) {
+        Queue& victim = queues[(worker + i) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.items.empty()) {
+            index = victim.items.back();
+            victim.items.pop_back();
+            return true;
+        }
+    }
+    // İşler yalnızca run() başında eklendiği için bütün kuyruklar boşsa iş bitmiştir
+    return false;
+}
+
+void WorkStealingPool::work(unsigned worker, const std::function<void(size_t, unsigned)>& task) {
+    size_t index;
+    while (next(worker, index)) task(index, worker);
+}
+
+void WorkStealingPool::run(size_t count, const std::function<void(size_t index, unsigned worker)>& task) {
+    for (size_t i = 0; i < count; ++i) queues[i % threadCount].items.push_back(i);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (unsigned w = 1; w < threadCount; ++w) {
+        threads.emplace_back(&WorkStealingPool::work, this, w, std::cref(task));
+    }
+    // Çağıran iş parçacığı da 0 numaralı işçi olarak çalışır
+    work(0, task);
+    for (std::thread& t : threads) t.join();
+}
@@ -0,0 +1,41 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// İş çalmalı (work-stealing) iş parçacığı havuzu
+// Her iş parçacığının kendi kuyruğu vardır; işler sırayla kuyruklara dağıtılır.
+// İş parçacığı kendi kuyruğunu baştan tüketir, kuyruğu boşalınca diğer
+// kuyrukların sonundan iş çalar. İşler büyükten küçüğe sıralı verilirse her
+// iş parçacığı önce büyük işleri alır ve sona yalnızca küçük işler kalır.
+class WorkStealingPool {
+public:
+    // threadCount 0 ise donanımın desteklediği iş parçacığı sayısı kullanılır
+    explicit WorkStealingPool(unsigned threadCount = 0);
+
+    unsigned size() const { return threadCount; }
+
+    // [0, count) aralığındaki her iş için task(index, worker) çağırır ve
+    // hepsi bitene kadar bekler. worker, çağıran iş parçacığının [0, size())
+    // aralığındaki numarasıdır; iş parçacığına özel durum için kullanılabilir.
+    void run(size_t count, const std::function<void(size_t index, unsigned worker)>& task);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> items;
+    };
+
+    unsigned threadCount;
+    std::unique_ptr<Queue[]> queues;
+
+    // Önce kendi kuyruğundan, o boşsa diğerlerinden bir iş alır
+    bool next(unsigned worker, size_t& index);
+    void work(unsigned worker, const std::function<void(size_t, unsigned)>& task);
+};
+
+#endif